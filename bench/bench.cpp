@@ -0,0 +1,569 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <cmath>
+#include <limits>
+#include <cstdint>
+#include <type_traits>
+#include <cstring>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "../header/Nodes.h"
+#include "../header/ThreadPool.h"
+#include "../header/Kernels.h"
+#include "../header/AlignedAllocator.h"
+#include "../header/GridMemory.h"
+
+using std::clog;	using std::endl;
+
+/**
+*	solver benchmark, everything it measures goes to one JSON document:
+*
+*	- stream: STREAM triad bandwidth per thread count, the roofline the
+*	  sweeps are held against
+*	- sweeps: Jacobi run for a fixed sweep budget per grid size, precision,
+*	  kernel instruction set and thread count; median/p95 ns per sweep,
+*	  cells per second and GB/s counted as STREAM does (read src, write dst,
+*	  read the fixed-node mask, no write-allocate)
+*	- convergence: every solver mode run to epsilon on the smaller grids;
+*	  iterations and median/p95 time to solution
+*	- memory: threaded Jacobi on one large double grid per GridMemoryPolicy,
+*	  huge pages off/transparent/explicit with and without first touch;
+*	  ns per sweep, GB/s, data TLB misses per sweep (null without a PMU) and
+*	  the huge page bytes the grid ended up resident in
+*	- outOfCore: OutOfCore on one large double grid per band height and
+*	  sweeps per band load, next to in-memory Jacobi; ns per sweep, store
+*	  read/write MB/s (through the page cache, the store is a temporary
+*	  file), the share of the solve spent waiting on a band and peak bytes
+*
+*	each repetition re-solves the same Nodes, so allocation, first touch
+*	and thread start-up stay out of the timings; warmup runs are discarded
+**/
+namespace bench
+{
+
+struct Options
+{
+	std::vector<uint64_t> sizes = {64, 128, 256, 512, 1024, 2048, 4096, 8192};
+	std::vector<unsigned int> threads;
+	std::vector<std::string> precisions = {"float", "double", "long double"};
+	std::vector<std::string> solvers = {"jacobi", "sor", "multigrid", "cg", "tiled", "mixed"};
+	unsigned int reps = 5, warmup = 1;
+	// convergence runs only on sizes up to this, Jacobi needs O(n^2) sweeps
+	uint64_t convergeMax = 128;
+	prec_t epsilon = 1e-5;
+	// configurations whose grids would not fit are reported as skipped
+	uint64_t maxBytes = 0;
+	// side of the grid of the memory section, 0 skips it
+	uint64_t memoryNodes = 4096;
+	// side of the grid of the outOfCore section, 0 skips it
+	uint64_t streamNodes = 4096;
+	std::string jsonPath;
+};
+
+struct Stats
+{
+	double median, p95;
+};
+
+Stats summarize(std::vector<double> samples)
+{
+	std::sort(samples.begin(), samples.end());
+	const uint64_t n = samples.size();
+	const double median = n % 2 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+	// nearest rank
+	const double p95 = samples[static_cast<uint64_t>(std::ceil(0.95 * n)) - 1];
+	return Stats{median, p95};
+}
+
+template<typename T> const char* precisionName(void);
+template<> const char* precisionName<float>(void) { return "float"; }
+template<> const char* precisionName<double>(void) { return "double"; }
+template<> const char* precisionName<long double>(void) { return "long double"; }
+
+const std::vector<std::pair<std::string, HMT::SolverMode>> solverModes = {
+	{"jacobi", HMT::SolverMode::Jacobi},
+	{"sor", HMT::SolverMode::RedBlackSOR},
+	{"multigrid", HMT::SolverMode::Multigrid},
+	{"cg", HMT::SolverMode::ConjugateGradient},
+	{"tiled", HMT::SolverMode::TiledJacobi},
+	{"mixed", HMT::SolverMode::MixedPrecision},
+	{"adi", HMT::SolverMode::ADI},
+	{"inplace", HMT::SolverMode::InPlace},
+	{"outofcore", HMT::SolverMode::OutOfCore},
+	{"distributed", HMT::SolverMode::Distributed}
+};
+
+// best of reps STREAM triad a = b + s * c, in GB/s
+double streamTriad(const unsigned int threadCnt, const unsigned int reps)
+{
+	const uint64_t n = 16 << 20;
+	HMT::AlignedVector<double> a(n, 1.0), b(n, 2.0), c(n, 0.5);
+	HMT::ThreadPool pool(threadCnt);
+	double best = 0;
+	for (unsigned int r = 0; r < reps + 1; ++r) {
+		const auto start = std::chrono::high_resolution_clock::now();
+		pool.run([&] (const unsigned int threadId) -> void {
+			const uint64_t begin = n * threadId / threadCnt, end = n * (threadId + 1) / threadCnt;
+			for (uint64_t i = begin; i < end; ++i)
+				a[i] = b[i] + 3.0 * c[i];
+		});
+		const std::chrono::duration<double> taken = std::chrono::high_resolution_clock::now() - start;
+		if (r > 0)
+			best = std::max(best, 3 * sizeof(double) * n / taken.count() / 1e9);
+	}
+	return best;
+}
+
+std::string skipped(const std::string& fields)
+{
+	return "{" + fields + ",\"skipped\":\"memory\"}";
+}
+
+template<typename T>
+HMT::Nodes<T> makePlate(const uint64_t& size, const unsigned int threadCnt)
+{
+	HMT::Nodes<T> nodes(size, size);
+	nodes.setWallTemp(500, 100, 100, 100);
+	nodes.setHeatSource(size / 4, size / 4, 300);
+	nodes.setHeatSource(size / 2, 3 * size / 4, -1000);
+	nodes.canUseThreads(threadCnt > 1);
+	nodes.setThreadCount(threadCnt);
+	nodes.setProcessCount(threadCnt);
+	return nodes;
+}
+
+template<typename T>
+void runSweeps(const Options& options, const std::map<unsigned int, double>& stream, std::vector<std::string>& records)
+{
+	std::vector<HMT::SimdIsa> isas = {HMT::SimdIsa::Scalar};
+	// only float and double have vector kernels
+	if (!std::is_same<T, long double>::value) {
+		for (const HMT::SimdIsa isa : {HMT::SimdIsa::SSE41, HMT::SimdIsa::AVX2, HMT::SimdIsa::AVX512})
+			if (isa <= HMT::Kernels::detectIsa())
+				isas.push_back(isa);
+	}
+	for (const uint64_t size : options.sizes) {
+		const uint64_t cells = (size - 2) * (size - 2);
+		// enough sweeps per repetition to dwarf the timer, at least 4
+		const uint64_t sweeps = std::max<uint64_t>(4, std::min<uint64_t>(2000, (16 << 20) / cells));
+		for (const unsigned int threadCnt : options.threads) {
+			for (const HMT::SimdIsa isa : isas) {
+				std::ostringstream fields;
+				fields << "\"solver\":\"jacobi\",\"isa\":\"" << HMT::Kernels::isaName(isa)
+					<< "\",\"precision\":\"" << precisionName<T>() << "\",\"nodes\":" << size
+					<< ",\"threads\":" << threadCnt;
+				if (size * size * (2 * sizeof(T) + 1) > options.maxBytes) {
+					records.push_back(skipped(fields.str()));
+					continue;
+				}
+				HMT::Kernels::setIsa(isa);
+				HMT::Nodes<T> nodes = makePlate<T>(size, threadCnt);
+				HMT::ConvergencePolicy policy;
+				policy.maxItterations = sweeps;
+				nodes.setConvergencePolicy(policy);
+				std::vector<double> nsPerSweep;
+				for (unsigned int r = 0; r < options.warmup + options.reps; ++r) {
+					nodes.setWallTemp(500, 100, 100, 100);
+					// epsilon 0 never converges, every run spends the whole budget
+					nodes.calculate(0);
+					if (r >= options.warmup)
+						nsPerSweep.push_back(static_cast<double>(nodes.getDuration().count()) / nodes.getItterCount());
+				}
+				const Stats stats = summarize(nsPerSweep);
+				const double gbs = cells * (2 * sizeof(T) + 1) / stats.median;
+				fields << ",\"sweeps\":" << sweeps << ",\"medianNsPerSweep\":" << stats.median
+					<< ",\"p95NsPerSweep\":" << stats.p95 << ",\"cellsPerSec\":" << cells / stats.median * 1e9
+					<< ",\"effectiveGBs\":" << gbs << ",\"rooflineFraction\":" << gbs / stream.at(threadCnt);
+				records.push_back("{" + fields.str() + "}");
+				clog << "sweeps " << precisionName<T>() << " " << size << "^2 " << HMT::Kernels::isaName(isa)
+					<< " x" << threadCnt << ": " << stats.median << "ns/sweep, " << gbs << "GB/s" << endl;
+			}
+		}
+	}
+	HMT::Kernels::setIsa(HMT::Kernels::detectIsa());
+}
+
+template<typename T>
+void runConvergence(const Options& options, std::vector<std::string>& records)
+{
+	// a change below a few hundred ulps of the hottest node (1000) is rounding
+	// noise, float SOR would stall above 1e-5 forever
+	const prec_t epsilon = std::max<prec_t>(options.epsilon, 1000 * 256 * std::numeric_limits<T>::epsilon());
+	for (const uint64_t size : options.sizes) {
+		if (size > options.convergeMax)
+			continue;
+		for (const auto& mode : solverModes) {
+			if (std::find(options.solvers.begin(), options.solvers.end(), mode.first) == options.solvers.end())
+				continue;
+			for (const unsigned int threadCnt : options.threads) {
+				HMT::Nodes<T> nodes = makePlate<T>(size, threadCnt);
+				nodes.setSolverMode(mode.second);
+				std::vector<double> ns;
+				for (unsigned int r = 0; r < options.warmup + options.reps; ++r) {
+					nodes.setWallTemp(500, 100, 100, 100);
+					nodes.calculate(epsilon);
+					if (r >= options.warmup)
+						ns.push_back(static_cast<double>(nodes.getDuration().count()));
+				}
+				const Stats stats = summarize(ns);
+				std::ostringstream fields;
+				fields << "{\"solver\":\"" << mode.first << "\",\"precision\":\"" << precisionName<T>()
+					<< "\",\"nodes\":" << size << ",\"threads\":" << threadCnt
+					<< ",\"epsilon\":" << static_cast<double>(epsilon)
+					<< ",\"itterations\":" << nodes.getItterCount()
+					<< ",\"converged\":" << (nodes.hasConverged() ? "true" : "false")
+					<< ",\"peakBytes\":" << nodes.getMemoryFootprint().peakBytes
+					<< ",\"medianNs\":" << stats.median << ",\"p95Ns\":" << stats.p95 << "}";
+				records.push_back(fields.str());
+				clog << "convergence " << precisionName<T>() << " " << size << "^2 " << mode.first
+					<< " x" << threadCnt << ": " << nodes.getItterCount() << " itterations, "
+					<< stats.median / 1e6 << "ms" << endl;
+			}
+		}
+	}
+}
+
+// data TLB load misses of this process, threads it starts from now on included
+// once they exit; -1 where perf events are not available (no PMU, paranoid > 2)
+class TlbCounter
+{
+public:
+	TlbCounter(void)
+	{
+		perf_event_attr attr;
+		std::memset(&attr, 0, sizeof(attr));
+		attr.size = sizeof(attr);
+		attr.type = PERF_TYPE_HW_CACHE;
+		attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+			(PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		attr.inherit = 1;
+		this->_fd = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+	}
+	~TlbCounter(void)
+	{
+		if (this->_fd >= 0)
+			::close(this->_fd);
+	}
+
+	int64_t read(void) const
+	{
+		uint64_t count = 0;
+		if (this->_fd < 0 || ::read(this->_fd, &count, sizeof(count)) != sizeof(count))
+			return -1;
+		return static_cast<int64_t>(count);
+	}
+
+private:
+	int _fd;
+};
+
+void runMemory(const Options& options, std::vector<std::string>& records)
+{
+	const uint64_t size = options.memoryNodes;
+	const unsigned int threadCnt = *std::max_element(options.threads.begin(), options.threads.end());
+	const uint64_t cells = (size - 2) * (size - 2);
+	const uint64_t sweeps = std::max<uint64_t>(4, std::min<uint64_t>(2000, (64 << 20) / cells));
+	const HMT::GridMemoryPolicy original = HMT::GridMemory::getPolicy();
+	const std::vector<std::pair<std::string, HMT::HugePages>> pageKinds = {
+		{"off", HMT::HugePages::Off}, {"transparent", HMT::HugePages::Transparent}, {"explicit", HMT::HugePages::Explicit}};
+	for (const auto& pages : pageKinds) {
+		for (const bool firstTouch : {false, true}) {
+			std::ostringstream fields;
+			fields << "\"hugePages\":\"" << pages.first << "\",\"firstTouch\":" << (firstTouch ? "true" : "false")
+				<< ",\"precision\":\"double\",\"nodes\":" << size << ",\"threads\":" << threadCnt;
+			if (size * size * (2 * sizeof(double) + 1) > options.maxBytes) {
+				records.push_back(skipped(fields.str()));
+				continue;
+			}
+			HMT::GridMemoryPolicy policy;
+			policy.hugePages = pages.second;
+			policy.firstTouch = firstTouch;
+			policy.pinWorkers = firstTouch;
+			HMT::GridMemory::setPolicy(policy);
+			const HMT::GridMemoryStats before = HMT::GridMemory::getStats();
+			// opened before the pool exists, its workers inherit it and add in when they exit
+			TlbCounter tlb;
+			std::vector<double> nsPerSweep;
+			uint64_t sweepsRun = 0;
+			int64_t residentHuge = 0;
+			{
+				HMT::Nodes<double> nodes = makePlate<double>(size, threadCnt);
+				HMT::ConvergencePolicy budget;
+				budget.maxItterations = sweeps;
+				nodes.setConvergencePolicy(budget);
+				for (unsigned int r = 0; r < options.warmup + options.reps; ++r) {
+					nodes.setWallTemp(500, 100, 100, 100);
+					nodes.calculate(0);
+					sweepsRun += nodes.getItterCount();
+					if (r >= options.warmup)
+						nsPerSweep.push_back(static_cast<double>(nodes.getDuration().count()) / nodes.getItterCount());
+				}
+				residentHuge = HMT::GridMemory::residentHugeBytes();
+			}
+			const int64_t misses = tlb.read();
+			const HMT::GridMemoryStats after = HMT::GridMemory::getStats();
+			const Stats stats = summarize(nsPerSweep);
+			const double gbs = cells * (2 * sizeof(double) + 1) / stats.median;
+			fields << ",\"sweeps\":" << sweeps << ",\"medianNsPerSweep\":" << stats.median
+				<< ",\"p95NsPerSweep\":" << stats.p95 << ",\"effectiveGBs\":" << gbs << ",\"dtlbMissesPerSweep\":";
+			// set-up and warmup are in the count too, spread over every sweep run
+			if (misses < 0)
+				fields << "null";
+			else
+				fields << static_cast<double>(misses) / sweepsRun;
+			fields << ",\"residentHugeMB\":" << (residentHuge >> 20)
+				<< ",\"fallbacks\":" << after.fallbacks - before.fallbacks
+				<< ",\"placedMB\":" << ((after.placedBytes - before.placedBytes) >> 20);
+			records.push_back("{" + fields.str() + "}");
+			clog << "memory " << size << "^2 x" << threadCnt << " " << pages.first << (firstTouch ? " first touch" : "")
+				<< ": " << stats.median << "ns/sweep, " << gbs << "GB/s, " << (misses < 0 ? "no" : std::to_string(misses))
+				<< " dTLB misses, " << (residentHuge >> 20) << "MB huge" << endl;
+		}
+	}
+	HMT::GridMemory::setPolicy(original);
+}
+
+void runOutOfCore(const Options& options, std::vector<std::string>& records)
+{
+	const uint64_t size = options.streamNodes;
+	const uint64_t cells = (size - 2) * (size - 2);
+	// a multiple of every step count below, so no pass runs short
+	const uint64_t sweeps = std::max<uint64_t>(1, std::min<uint64_t>(25, (64 << 20) / cells)) * 8;
+	HMT::ConvergencePolicy budget;
+	budget.maxItterations = sweeps;
+	struct Shape { uint64_t bandRows; unsigned int steps; };
+	// 0 rows is the in-memory Jacobi reference
+	const std::vector<Shape> shapes = {{0, 0}, {256, 1}, {256, 4}, {256, 8}, {1024, 8}};
+	for (const Shape& shape : shapes) {
+		std::ostringstream fields;
+		fields << "\"solver\":\"" << (shape.bandRows ? "outofcore" : "jacobi") << "\",\"precision\":\"double\""
+			<< ",\"nodes\":" << size << ",\"bandRows\":" << shape.bandRows << ",\"steps\":" << shape.steps;
+		if (shape.bandRows == 0 && size * size * (2 * sizeof(double) + 1) > options.maxBytes) {
+			records.push_back(skipped(fields.str()));
+			continue;
+		}
+		HMT::Nodes<double> nodes = makePlate<double>(size, 1);
+		nodes.setConvergencePolicy(budget);
+		if (shape.bandRows) {
+			nodes.setSolverMode(HMT::SolverMode::OutOfCore);
+			nodes.setStreaming("", shape.bandRows, shape.steps);
+		}
+		std::vector<double> nsPerSweep, readMBs, writeMBs, stall;
+		for (unsigned int r = 0; r < options.warmup + options.reps; ++r) {
+			nodes.setWallTemp(500, 100, 100, 100);
+			nodes.calculate(0);
+			if (r < options.warmup)
+				continue;
+			const HMT::StreamStats io = nodes.getStreamStats();
+			// the spill and read back are part of the solve, the per sweep time includes them
+			nsPerSweep.push_back(static_cast<double>(nodes.getDuration().count()) / nodes.getItterCount());
+			readMBs.push_back(io.readTime.count() ? io.bytesRead * 1e3 / io.readTime.count() : 0);
+			writeMBs.push_back(io.writeTime.count() ? io.bytesWritten * 1e3 / io.writeTime.count() : 0);
+			stall.push_back(io.passTime.count() ? static_cast<double>(io.stallTime.count()) / io.passTime.count() : 0);
+		}
+		const Stats stats = summarize(nsPerSweep);
+		const HMT::MemoryFootprint footprint = nodes.getMemoryFootprint();
+		fields << ",\"sweeps\":" << sweeps << ",\"medianNsPerSweep\":" << stats.median
+			<< ",\"p95NsPerSweep\":" << stats.p95 << ",\"readMBs\":" << summarize(readMBs).median
+			<< ",\"writeMBs\":" << summarize(writeMBs).median << ",\"stallShare\":" << summarize(stall).median
+			<< ",\"scratchBytes\":" << footprint.scratchBytes << ",\"peakBytes\":" << footprint.peakBytes;
+		records.push_back("{" + fields.str() + "}");
+		clog << "outOfCore " << size << "^2 " << (shape.bandRows ? "rows " + std::to_string(shape.bandRows) +
+			" steps " + std::to_string(shape.steps) : std::string("in memory")) << ": " << stats.median
+			<< "ns/sweep, read " << summarize(readMBs).median << "MB/s, write " << summarize(writeMBs).median
+			<< "MB/s, stalled " << 100 * summarize(stall).median << "%" << endl;
+	}
+}
+
+template<typename N>
+std::vector<N> parseList(const std::string& text)
+{
+	std::vector<N> values;
+	std::istringstream in(text);
+	std::string item;
+	while (std::getline(in, item, ','))
+		values.push_back(static_cast<N>(std::stoull(item)));
+	return values;
+}
+
+std::vector<std::string> splitList(const std::string& text)
+{
+	std::vector<std::string> items;
+	std::istringstream in(text);
+	std::string item;
+	while (std::getline(in, item, ','))
+		items.push_back(item);
+	return items;
+}
+
+void usage(void)
+{
+	clog << "bench.out [--sizes 64,128,...] [--threads 1,4] [--precisions float,double,long double]" << endl
+		 << "          [--solvers jacobi,sor,multigrid,cg,tiled,mixed] [--reps 5] [--warmup 1]" << endl
+		 << "          [--converge-max 128] [--epsilon 1e-5] [--max-mb N] [--memory-nodes 4096]" << endl
+		 << "          [--stream-nodes 4096] [--json out.json] [--quick]" << endl;
+}
+
+bool parseOptions(const int argc, char const* argv[], Options& options)
+{
+	const unsigned int hardware = std::max(1u, std::thread::hardware_concurrency());
+	options.threads = hardware > 1 ? std::vector<unsigned int>{1, hardware} : std::vector<unsigned int>{1};
+	options.maxBytes = static_cast<uint64_t>(::sysconf(_SC_PHYS_PAGES)) * ::sysconf(_SC_PAGESIZE) / 2;
+	for (int i = 1; i < argc; ++i) {
+		const std::string arg = argv[i];
+		if (arg == "--quick") {
+			options.sizes = {64, 256, 1024};
+			options.reps = 3;
+			options.memoryNodes = 2048;
+			options.streamNodes = 2048;
+			continue;
+		}
+		if (i + 1 >= argc) {
+			usage();
+			return false;
+		}
+		const std::string value = argv[++i];
+		if (arg == "--sizes")
+			options.sizes = parseList<uint64_t>(value);
+		else if (arg == "--threads")
+			options.threads = parseList<unsigned int>(value);
+		else if (arg == "--precisions")
+			options.precisions = splitList(value);
+		else if (arg == "--solvers")
+			options.solvers = splitList(value);
+		else if (arg == "--reps")
+			options.reps = std::max(1ull, std::stoull(value));
+		else if (arg == "--warmup")
+			options.warmup = std::stoul(value);
+		else if (arg == "--converge-max")
+			options.convergeMax = std::stoull(value);
+		else if (arg == "--epsilon")
+			options.epsilon = std::stold(value);
+		else if (arg == "--max-mb")
+			options.maxBytes = std::stoull(value) << 20;
+		else if (arg == "--memory-nodes")
+			options.memoryNodes = std::stoull(value);
+		else if (arg == "--stream-nodes")
+			options.streamNodes = std::stoull(value);
+		else if (arg == "--json")
+			options.jsonPath = value;
+		else {
+			usage();
+			return false;
+		}
+	}
+	options.sizes.erase(std::remove_if(options.sizes.begin(), options.sizes.end(),
+		[] (const uint64_t& size) { return size < 3; }), options.sizes.end());
+	return true;
+}
+
+bool hasPrecision(const Options& options, const std::string& name)
+{
+	return std::find(options.precisions.begin(), options.precisions.end(), name) != options.precisions.end();
+}
+
+}
+
+int main(int argc, char const *argv[])
+{
+	bench::Options options;
+	try {
+		if (!bench::parseOptions(argc, argv, options))
+			return 2;
+	} catch (const std::exception&) {
+		bench::usage();
+		return 2;
+	}
+
+	std::map<unsigned int, double> stream;
+	std::vector<std::string> streamRecords, sweepRecords, convergenceRecords, memoryRecords, outOfCoreRecords;
+	for (const unsigned int threadCnt : options.threads) {
+		stream[threadCnt] = bench::streamTriad(threadCnt, options.reps);
+		std::ostringstream record;
+		record << "{\"threads\":" << threadCnt << ",\"triadGBs\":" << stream[threadCnt] << "}";
+		streamRecords.push_back(record.str());
+		clog << "stream triad x" << threadCnt << ": " << stream[threadCnt] << "GB/s" << endl;
+	}
+
+	const bool hasJacobi = std::find(options.solvers.begin(), options.solvers.end(), "jacobi") != options.solvers.end();
+	if (bench::hasPrecision(options, "float")) {
+		if (hasJacobi)
+			bench::runSweeps<float>(options, stream, sweepRecords);
+		bench::runConvergence<float>(options, convergenceRecords);
+	}
+	if (bench::hasPrecision(options, "double")) {
+		if (hasJacobi)
+			bench::runSweeps<double>(options, stream, sweepRecords);
+		bench::runConvergence<double>(options, convergenceRecords);
+	}
+	if (bench::hasPrecision(options, "long double")) {
+		if (hasJacobi)
+			bench::runSweeps<long double>(options, stream, sweepRecords);
+		bench::runConvergence<long double>(options, convergenceRecords);
+	}
+
+	if (options.memoryNodes >= 3)
+		bench::runMemory(options, memoryRecords);
+	if (options.streamNodes >= 3)
+		bench::runOutOfCore(options, outOfCoreRecords);
+
+	std::ofstream file;
+	if (!options.jsonPath.empty())
+		file.open(options.jsonPath);
+	std::ostream& json = file.is_open() ? file : std::cout;
+	const auto array = [&json] (const char* name, const std::vector<std::string>& records, const bool isLast) {
+		json << "  \"" << name << "\": [";
+		for (uint64_t i = 0; i < records.size(); ++i)
+			json << (i ? ",\n    " : "\n    ") << records[i];
+		json << (records.empty() ? "]" : "\n  ]") << (isLast ? "\n" : ",\n");
+	};
+	json << std::setprecision(6);
+	json << "{\n  \"host\": {\"hardwareThreads\":" << std::thread::hardware_concurrency()
+		 << ",\"isa\":\"" << HMT::Kernels::isaName(HMT::Kernels::detectIsa()) << "\",\"reps\":" << options.reps
+		 << ",\"warmup\":" << options.warmup << "},\n";
+	array("stream", streamRecords, false);
+	array("sweeps", sweepRecords, false);
+	array("convergence", convergenceRecords, false);
+	array("memory", memoryRecords, false);
+	array("outOfCore", outOfCoreRecords, true);
+	json << "}" << endl;
+	return 0;
+}
@@ -0,0 +1,78 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+#ifndef ALIGNED_ALLOCATOR_CXX
+#define ALIGNED_ALLOCATOR_CXX
+
+#include <cstdlib>
+#include <new>
+#include <limits>
+
+#include "../header/AlignedAllocator.h"
+#include "../header/GridMemory.h"
+
+namespace HMT
+{
+
+template<typename T, std::size_t Align>
+T* AlignedAllocator<T, Align>::allocate(std::size_t n)
+{
+	if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+		throw std::bad_alloc();
+	if (GridMemory::isMapped(n * sizeof(T))) {
+		void* ptr = GridMemory::map(n * sizeof(T));
+		if (!ptr)
+			throw std::bad_alloc();
+		return static_cast<T*>(ptr);
+	}
+	void* ptr = nullptr;
+	if (posix_memalign(&ptr, Align, n * sizeof(T)) != 0)
+		throw std::bad_alloc();
+	return static_cast<T*>(ptr);
+}
+
+template<typename T, std::size_t Align>
+void AlignedAllocator<T, Align>::deallocate(T* ptr, std::size_t n) noexcept(true)
+{
+	if (GridMemory::isMapped(n * sizeof(T)))
+		GridMemory::unmap(ptr, n * sizeof(T));
+	else
+		std::free(ptr);
+}
+
+template<typename T, typename U, std::size_t Align>
+bool operator==(const AlignedAllocator<T, Align>&, const AlignedAllocator<U, Align>&) noexcept(true)
+{
+	return true;
+}
+
+template<typename T, typename U, std::size_t Align>
+bool operator!=(const AlignedAllocator<T, Align>&, const AlignedAllocator<U, Align>&) noexcept(true)
+{
+	return false;
+}
+
+}
+
+#endif
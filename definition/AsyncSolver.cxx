@@ -0,0 +1,188 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+
+#ifndef ASYNC_SOLVER_CXX
+#define ASYNC_SOLVER_CXX
+
+#include <algorithm>
+#include <exception>
+
+#include "../header/AsyncSolver.h"
+
+namespace HMT
+{
+
+template<typename T>
+SolveHandle<T>::SolveHandle(const std::shared_ptr<Nodes<T>>& nodes, const std::shared_ptr<SolveControl>& control,
+		const std::shared_future<void>& done): _nodes(nodes), _control(control), _done(done)
+{ }
+
+template<typename T>
+bool SolveHandle<T>::isValid(void) const noexcept(true)
+{
+	return this->_control != nullptr;
+}
+
+template<typename T>
+SolveProgress SolveHandle<T>::getProgress(void) const noexcept(true)
+{
+	return this->_control->getProgress();
+}
+
+template<typename T>
+void SolveHandle<T>::cancel(void) const noexcept(true)
+{
+	this->_control->cancel();
+}
+
+template<typename T>
+bool SolveHandle<T>::isReady(void) const
+{
+	return this->_done.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+template<typename T>
+void SolveHandle<T>::wait(void) const
+{
+	this->_done.wait();
+}
+
+template<typename T> template<typename Rep, typename Period>
+bool SolveHandle<T>::waitFor(const std::chrono::duration<Rep, Period>& timeout) const
+{
+	return this->_done.wait_for(timeout) == std::future_status::ready;
+}
+
+template<typename T>
+const Nodes<T>& SolveHandle<T>::get(void) const
+{
+	this->_done.get();
+	return *(this->_nodes);
+}
+
+template<typename T>
+AsyncSolver<T>::AsyncSolver(const unsigned int workerCnt): _stop(false)
+{
+	const unsigned int count = workerCnt > 0 ? workerCnt : std::max(1u, std::thread::hardware_concurrency());
+	for (unsigned int i = 0; i < count; ++i)
+		this->_workers.push_back(std::thread(&AsyncSolver<T>::workerLoop, this));
+}
+
+template<typename T>
+AsyncSolver<T>::~AsyncSolver(void)
+{
+	{
+		std::lock_guard<std::mutex> guard(this->_mutex);
+		this->_stop = true;
+		// queued solves still run their one iteration, so nobody waits on a dead promise
+		for (Job& job : this->_queue)
+			job.control->cancel();
+		for (const std::shared_ptr<SolveControl>& control : this->_running)
+			control->cancel();
+	}
+	this->_wake.notify_all();
+	for (auto& i : this->_workers)
+		i.join();
+}
+
+template<typename T>
+SolveHandle<T> AsyncSolver<T>::submit(const Nodes<T>& nodes, const prec_t epsilon, const clock::time_point& deadline,
+		const std::shared_ptr<Telemetry>& telemetry)
+{
+	Job job;
+	job.nodes = std::make_shared<Nodes<T>>(nodes);
+	// a telemetry ring takes one producer, and two solves of one plate would
+	// rename the same checkpoint and queue on the same pool
+	job.nodes->detachShared();
+	job.nodes->setTelemetry(telemetry);
+	job.control = std::make_shared<SolveControl>();
+	job.control->setDeadline(deadline);
+	job.epsilon = epsilon;
+	const SolveHandle<T> handle(job.nodes, job.control, job.done.get_future().share());
+	{
+		std::lock_guard<std::mutex> guard(this->_mutex);
+		if (this->_stop)
+			job.control->cancel();
+		this->_queue.push_back(std::move(job));
+	}
+	this->_wake.notify_one();
+	return handle;
+}
+
+template<typename T>
+unsigned int AsyncSolver<T>::size(void) const noexcept(true)
+{
+	return static_cast<unsigned int>(this->_workers.size());
+}
+
+template<typename T>
+uint64_t AsyncSolver<T>::pending(void)
+{
+	std::lock_guard<std::mutex> guard(this->_mutex);
+	return this->_queue.size();
+}
+
+template<typename T>
+AsyncSolver<T>& AsyncSolver<T>::shared(void)
+{
+	static AsyncSolver<T> solver(0);
+	return solver;
+}
+
+template<typename T>
+void AsyncSolver<T>::workerLoop(void)
+{
+	while (true) {
+		Job job;
+		{
+			std::unique_lock<std::mutex> lock(this->_mutex);
+			this->_wake.wait(lock, [this] { return this->_stop || !this->_queue.empty(); });
+			if (this->_queue.empty())
+				return;
+			job = std::move(this->_queue.front());
+			this->_queue.pop_front();
+			this->_running.push_back(job.control);
+		}
+		job.control->setStatus(SolveStatus::Running);
+		job.nodes->setSolveControl(job.control);
+		try {
+			job.nodes->calculate(job.epsilon);
+			job.nodes->setSolveControl(nullptr);
+			if (!job.control->isStopped())
+				job.control->setStatus(job.nodes->hasConverged() ? SolveStatus::Converged : SolveStatus::Unconverged);
+			job.done.set_value();
+		} catch (...) {
+			job.nodes->setSolveControl(nullptr);
+			job.control->setStatus(SolveStatus::Unconverged);
+			job.done.set_exception(std::current_exception());
+		}
+		std::lock_guard<std::mutex> guard(this->_mutex);
+		this->_running.erase(std::find(this->_running.begin(), this->_running.end(), job.control));
+	}
+}
+
+}
+
+#endif
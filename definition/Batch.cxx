@@ -0,0 +1,401 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+#ifndef BATCH_CXX
+#define BATCH_CXX
+
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+#include "../header/Batch.h"
+
+namespace HMT
+{
+
+template<typename T>
+BatchSolver<T>::BatchSolver(const uint64_t& nodeX, const uint64_t& nodeY): _nodeX(nodeX), _nodeY(nodeY),
+	_threadCnt(0), _laneCnt(1), _interleaved(true), _hasSolved(false), _stealCnt(0)
+{ }
+
+template<typename T>
+void BatchSolver<T>::setThreadCount(const unsigned int threadCnt) noexcept(true)
+{
+	this->_threadCnt = threadCnt;
+}
+
+template<typename T>
+unsigned int BatchSolver<T>::getThreadCount(void) const noexcept(true)
+{
+	const unsigned int threadCnt = this->_threadCnt > 0 ? this->_threadCnt : std::thread::hardware_concurrency();
+	return threadCnt > 0 ? threadCnt : 1;
+}
+
+template<typename T>
+void BatchSolver<T>::setInterleaved(const bool choice) noexcept(true)
+{
+	this->_interleaved = choice;
+}
+
+template<typename T>
+bool BatchSolver<T>::getInterleaved(void) const noexcept(true)
+{
+	return this->_interleaved;
+}
+
+template<typename T>
+inline uint64_t BatchSolver<T>::index(const uint64_t& posX, const uint64_t& posY) const noexcept(true)
+{
+	return posY * this->_nodeX + posX;
+}
+
+template<typename T>
+bool BatchSolver<T>::hasSharedLayout(const std::vector<Scenario<T>>& scenarios) const
+{
+	std::vector<uint64_t> first, other;
+	for (uint64_t s = 0; s < scenarios.size(); ++s) {
+		std::vector<uint64_t>& positions = s == 0 ? first : other;
+		positions.clear();
+		for (const auto& i : scenarios[s].heatSources)
+			positions.push_back(this->index(i.first.first, i.first.second));
+		std::sort(positions.begin(), positions.end());
+		positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+		if (s > 0 && positions != first)
+			return false;
+	}
+	return true;
+}
+
+template<typename T>
+void BatchSolver<T>::initGrid(const Scenario<T>& scenario, T* grid, uint8_t* isFixed) const
+{
+	// the same order of writes as setWallTemp followed by setHeatSource
+	for (uint64_t i = 0; i < this->_nodeY; ++i) {
+		grid[this->index(0, i)] = scenario.tempWest;
+		grid[this->index(this->_nodeX - 1, i)] = scenario.tempEast;
+	}
+	for (uint64_t i = 0; i < this->_nodeX; ++i) {
+		grid[this->index(i, 0)] = scenario.tempNorth;
+		grid[this->index(i, this->_nodeY - 1)] = scenario.tempSouth;
+	}
+	const T mean = (scenario.tempNorth + scenario.tempEast + scenario.tempSouth + scenario.tempWest) / 4;
+	for (uint64_t i = 1; i < this->_nodeY - 1; ++i)
+		std::fill(grid + this->index(1, i), grid + this->index(this->_nodeX - 1, i), mean);
+	if (isFixed)
+		std::fill(isFixed, isFixed + this->_nodeX * this->_nodeY, 0);
+	for (const auto& i : scenario.heatSources) {
+		grid[this->index(i.first.first, i.first.second)] = i.second;
+		if (isFixed)
+			isFixed[this->index(i.first.first, i.first.second)] = 1;
+	}
+}
+
+template<typename T>
+uint64_t BatchSolver<T>::solveOne(const uint8_t* isFixed, T* result, T* scratch, const prec_t& epsilon) const
+{
+	std::copy(result, result + this->_nodeX * this->_nodeY, scratch);
+	T* src = result;
+	T* dst = scratch;
+	uint64_t itterCnt = 0;
+	prec_t diff = epsilon;
+	while (epsilon <= diff) {
+		++itterCnt;
+		diff = 0.0f;
+		for (uint64_t i = 1; i < this->_nodeY - 1; ++i) {
+			diff = std::max(diff, Kernels::jacobiRow(src + this->index(0, i - 1), src + this->index(0, i),
+				src + this->index(0, i + 1), isFixed + this->index(0, i),
+				dst + this->index(0, i), 1, this->_nodeX - 1));
+		}
+		std::swap(src, dst);
+	}
+	if (src != result)
+		std::copy(src, src + this->_nodeX * this->_nodeY, result);
+	return itterCnt;
+}
+
+template<typename T>
+inline __attribute__((always_inline)) void BatchSolver<T>::sweepPack(
+		const uint8_t* isFixed, const vec* src, vec* dst, const mask& frozen,
+		vec& diff) const noexcept(true)
+{
+	const vec zero = {};
+	diff = zero;
+	for (uint64_t i = 1; i < this->_nodeY - 1; ++i) {
+		for (uint64_t k = this->index(1, i); k < this->index(this->_nodeX - 1, i); ++k) {
+			const vec c = src[k];
+			if (isFixed[k]) {
+				dst[k] = c;
+				continue;
+			}
+			const vec temp = (src[k - this->_nodeX] + src[k + this->_nodeX] + src[k - 1] + src[k + 1]) / static_cast<T>(4);
+			const vec value = frozen ? c : temp;
+			dst[k] = value;
+			const vec change = value - c;
+			const vec magnitude = change < zero ? -change : change;
+			diff = magnitude > diff ? magnitude : diff;
+		}
+	}
+}
+
+template<typename T>
+void BatchSolver<T>::sweepPackDefault(
+		const uint8_t* isFixed, const vec* src, vec* dst, const mask& frozen,
+		vec& diff) const noexcept(true)
+{
+	this->sweepPack(isFixed, src, dst, frozen, diff);
+}
+
+// the same sweep with the 256-bit lanes in single registers
+template<typename T>
+__attribute__((target("avx2"))) void BatchSolver<T>::sweepPackAvx2(
+		const uint8_t* isFixed, const vec* src, vec* dst, const mask& frozen,
+		vec& diff) const noexcept(true)
+{
+	this->sweepPack(isFixed, src, dst, frozen, diff);
+}
+
+template<typename T>
+void BatchSolver<T>::solvePack(const std::vector<Scenario<T>>& scenarios, const uint64_t& first,
+		const uint8_t* isFixed, T* src, T* dst, T* grid, const prec_t& epsilon)
+{
+	typedef typename Lanes<T>::mask mask;
+	typedef typename Lanes<T>::maskLane maskLane;
+	const unsigned int width = Lanes<T>::width;
+	const uint64_t cells = this->_nodeX * this->_nodeY;
+	const uint64_t lanes = std::min<uint64_t>(width, scenarios.size() - first);
+
+	// a short last pack repeats its last scenario in the spare lanes
+	for (unsigned int l = 0; l < width; ++l) {
+		this->initGrid(scenarios[first + std::min<uint64_t>(l, lanes - 1)], grid, nullptr);
+		for (uint64_t k = 0; k < cells; ++k)
+			src[k * width + l] = grid[k];
+	}
+	std::copy(src, src + cells * width, dst);
+
+	vec* s = reinterpret_cast<vec*>(src);
+	vec* d = reinterpret_cast<vec*>(dst);
+	// a lane stops changing once it converged, so it ends on the sweep a lone solve would
+	mask frozen = {};
+	uint64_t itterCnts[width];
+	unsigned int active = width;
+	uint64_t itterCnt = 0;
+	const bool useAvx2 = Kernels::activeIsa() >= SimdIsa::AVX2;
+	vec diff;
+	while (active > 0) {
+		++itterCnt;
+		if (useAvx2)
+			this->sweepPackAvx2(isFixed, s, d, frozen, diff);
+		else
+			this->sweepPackDefault(isFixed, s, d, frozen, diff);
+		std::swap(s, d);
+		for (unsigned int l = 0; l < width; ++l) {
+			maskLane& isFrozen = reinterpret_cast<maskLane*>(&frozen)[l];
+			if (!isFrozen && static_cast<prec_t>(reinterpret_cast<const T*>(&diff)[l]) < epsilon) {
+				isFrozen = -1;
+				itterCnts[l] = itterCnt;
+				--active;
+			}
+		}
+	}
+
+	const T* lastGen = reinterpret_cast<const T*>(s);
+	for (uint64_t l = 0; l < lanes; ++l) {
+		T* result = this->_results.data() + (first + l) * cells;
+		for (uint64_t k = 0; k < cells; ++k)
+			result[k] = lastGen[k * width + l];
+		this->_itterCnts[first + l] = itterCnts[l];
+	}
+}
+
+template<typename T>
+bool BatchSolver<T>::takeFront(std::atomic<uint64_t>& range, uint64_t& item) noexcept(true)
+{
+	uint64_t bounds = range.load(std::memory_order_relaxed);
+	while (true) {
+		const uint64_t front = bounds & 0xffffffffu, back = bounds >> 32;
+		if (front >= back)
+			return false;
+		if (range.compare_exchange_weak(bounds, (back << 32) | (front + 1))) {
+			item = front;
+			return true;
+		}
+	}
+}
+
+template<typename T>
+bool BatchSolver<T>::stealBack(std::atomic<uint64_t>& range, uint64_t& item) noexcept(true)
+{
+	uint64_t bounds = range.load(std::memory_order_relaxed);
+	while (true) {
+		const uint64_t front = bounds & 0xffffffffu, back = bounds >> 32;
+		if (front >= back)
+			return false;
+		if (range.compare_exchange_weak(bounds, ((back - 1) << 32) | front)) {
+			item = back - 1;
+			return true;
+		}
+	}
+}
+
+template<typename T>
+void BatchSolver<T>::solve(const std::vector<Scenario<T>>& scenarios, const prec_t epsilon)
+{
+	this->_startTime = std::chrono::high_resolution_clock::now();
+	const uint64_t cells = this->_nodeX * this->_nodeY;
+	const uint64_t count = scenarios.size();
+	this->_results.resize(count * cells);
+	this->_itterCnts.assign(count, 0);
+	this->_stealCnt = 0;
+
+	// the fixed-node mask every scenario shares, built once for the batch
+	const bool isShared = this->hasSharedLayout(scenarios);
+	this->_laneCnt = this->_interleaved && isShared && Lanes<T>::width > 1 ? Lanes<T>::width : 1;
+	std::vector<uint8_t> sharedFixed;
+	if (isShared && count > 0) {
+		sharedFixed.resize(cells);
+		this->initGrid(scenarios[0], this->_results.data(), sharedFixed.data());
+	}
+
+	const uint64_t items = (count + this->_laneCnt - 1) / this->_laneCnt;
+	unsigned int nofThreads = this->getThreadCount();
+	if (nofThreads > items)
+		nofThreads = items > 0 ? static_cast<unsigned int>(items) : 1;
+	if (!this->_threadPool || this->_threadPool->size() != nofThreads)
+		this->_threadPool = std::make_shared<ThreadPool>(nofThreads);
+
+	struct alignas(64) WorkRange { std::atomic<uint64_t> bounds; uint64_t stealCnt; };
+	std::vector<WorkRange> ranges(nofThreads);
+	for (unsigned int t = 0; t < nofThreads; ++t) {
+		ranges[t].bounds.store(((items * (t + 1) / nofThreads) << 32) | (items * t / nofThreads));
+		ranges[t].stealCnt = 0;
+	}
+
+	this->_threadPool->run([&] (const unsigned int threadId) -> void {
+		AlignedVector<T> scratch(this->_laneCnt > 1 ? (2 * this->_laneCnt + 1) * cells : cells);
+		std::vector<uint8_t> ownFixed(isShared ? 0 : cells);
+		uint64_t item;
+		while (true) {
+			if (!takeFront(ranges[threadId].bounds, item)) {
+				// rob whoever has the most left, from the end they reach last
+				unsigned int victim = threadId;
+				uint64_t most = 0;
+				for (unsigned int t = 0; t < nofThreads; ++t) {
+					const uint64_t bounds = ranges[t].bounds.load(std::memory_order_relaxed);
+					const uint64_t front = bounds & 0xffffffffu, back = bounds >> 32;
+					if (back > front && back - front > most) {
+						most = back - front;
+						victim = t;
+					}
+				}
+				if (most == 0)
+					break;
+				if (!stealBack(ranges[victim].bounds, item))
+					continue;
+				++(ranges[threadId].stealCnt);
+			}
+
+			if (this->_laneCnt > 1) {
+				this->solvePack(scenarios, item * this->_laneCnt, sharedFixed.data(), scratch.data(),
+					scratch.data() + this->_laneCnt * cells, scratch.data() + 2 * this->_laneCnt * cells, epsilon);
+			} else {
+				T* result = this->_results.data() + item * cells;
+				this->initGrid(scenarios[item], result, isShared ? nullptr : ownFixed.data());
+				this->_itterCnts[item] = this->solveOne(isShared ? sharedFixed.data() : ownFixed.data(),
+					result, scratch.data(), epsilon);
+			}
+		}
+	});
+
+	for (const WorkRange& range : ranges)
+		this->_stealCnt += range.stealCnt;
+	this->_endTime = std::chrono::high_resolution_clock::now();
+	this->_hasSolved = true;
+}
+
+template<typename T>
+uint64_t BatchSolver<T>::size(void) const noexcept(true)
+{
+	return this->_itterCnts.size();
+}
+
+template<typename T>
+const AlignedVector<T>& BatchSolver<T>::getResults(void) const noexcept(true)
+{
+	return this->_results;
+}
+
+template<typename T>
+const T* BatchSolver<T>::getResult(const uint64_t& scenario) const noexcept(true)
+{
+	return this->_results.data() + scenario * this->_nodeX * this->_nodeY;
+}
+
+template<typename T>
+T BatchSolver<T>::getTemp(const uint64_t& scenario, const uint64_t& posX, const uint64_t& posY) const
+{
+	if (!this->_hasSolved || scenario >= this->size() || posX >= this->_nodeX || posY >= this->_nodeY)
+		return 0;
+	return this->getResult(scenario)[this->index(posX, posY)];
+}
+
+template<typename T>
+uint64_t BatchSolver<T>::getItterCount(const uint64_t& scenario) const
+{
+	return this->_hasSolved && scenario < this->size() ? this->_itterCnts[scenario] : 0;
+}
+
+template<typename T>
+bool BatchSolver<T>::writeResult(const uint64_t& scenario, const std::string& path, const ResultFormat format,
+		const unsigned int precision) const
+{
+	return this->_hasSolved && scenario < this->size() &&
+		ResultWriter::write(path, format, this->_nodeX, this->_nodeY, this->getResult(scenario), precision);
+}
+
+template<typename T>
+unsigned int BatchSolver<T>::getLaneCount(void) const noexcept(true)
+{
+	return this->_laneCnt;
+}
+
+template<typename T>
+uint64_t BatchSolver<T>::getStealCount(void) const noexcept(true)
+{
+	return this->_stealCnt;
+}
+
+template<typename T>
+std::chrono::nanoseconds BatchSolver<T>::getDuration(void) const
+{
+	if (!this->_hasSolved)
+		return std::chrono::nanoseconds(0);
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(this->_endTime - this->_startTime);
+}
+
+}
+
+#endif
@@ -0,0 +1,173 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+#ifndef CHECKPOINT_CXX
+#define CHECKPOINT_CXX
+
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "../header/Checkpoint.h"
+
+namespace HMT
+{
+
+namespace
+{
+
+const char checkpointMagic[8] = {'H', 'M', 'T', 'C', 'K', 'P', 'T', '\0'};
+
+inline uint64_t alignCheckpointOffset(const uint64_t& offset) noexcept(true)
+{
+	return (offset + 63) & ~static_cast<uint64_t>(63);
+}
+
+}
+
+inline CheckpointFile::CheckpointFile(const std::string& path): _map(nullptr), _size(0), _isValid(false)
+{
+	const int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return;
+	struct stat info;
+	if (::fstat(fd, &info) == 0 && static_cast<uint64_t>(info.st_size) >= sizeof(CheckpointHeader)) {
+		void* map = ::mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (map != MAP_FAILED) {
+			this->_map = static_cast<const char*>(map);
+			this->_size = info.st_size;
+			::madvise(map, this->_size, MADV_SEQUENTIAL);
+		}
+	}
+	::close(fd);
+	if (!this->_map)
+		return;
+
+	// every product and sum below is checked before it is formed, a corrupt
+	// header must not wrap around into something that fits the file
+	const CheckpointHeader& head = this->header();
+	const bool isShaped = head.nodeX >= 3 && head.nodeY >= 3 && head.valueSize > 0 &&
+		head.nodeY <= std::numeric_limits<uint64_t>::max() / head.nodeX;
+	const uint64_t cells = isShaped ? head.nodeX * head.nodeY : 0;
+	this->_isValid = isShaped && std::memcmp(head.magic, checkpointMagic, sizeof(checkpointMagic)) == 0 &&
+		head.version == CheckpointFile::version && head.byteOrder == 0x01020304 &&
+		head.valueOffset % 64 == 0 && head.maskOffset % 64 == 0 &&
+		head.valueOffset <= head.maskOffset && head.maskOffset <= this->_size &&
+		cells <= (head.maskOffset - head.valueOffset) / head.valueSize &&
+		cells <= this->_size - head.maskOffset;
+}
+
+inline CheckpointFile::~CheckpointFile(void)
+{
+	if (this->_map)
+		::munmap(const_cast<char*>(this->_map), this->_size);
+}
+
+inline bool CheckpointFile::isValid(void) const noexcept(true)
+{
+	return this->_isValid;
+}
+
+inline const CheckpointHeader& CheckpointFile::header(void) const noexcept(true)
+{
+	return *reinterpret_cast<const CheckpointHeader*>(this->_map);
+}
+
+template<typename T>
+inline bool CheckpointFile::holds(void) const noexcept(true)
+{
+	return this->_isValid && this->header().valueSize == sizeof(T) &&
+		this->header().valueDigits == static_cast<uint32_t>(std::numeric_limits<T>::digits);
+}
+
+template<typename T>
+inline const T* CheckpointFile::values(void) const noexcept(true)
+{
+	return reinterpret_cast<const T*>(this->_map + this->header().valueOffset);
+}
+
+inline const uint8_t* CheckpointFile::mask(void) const noexcept(true)
+{
+	return reinterpret_cast<const uint8_t*>(this->_map + this->header().maskOffset);
+}
+
+inline bool CheckpointFile::writeAll(const int fd, const void* data, uint64_t size)
+{
+	const char* bytes = static_cast<const char*>(data);
+	while (size > 0) {
+		const ssize_t written = ::write(fd, bytes, size);
+		if (written <= 0)
+			return false;
+		bytes += written;
+		size -= written;
+	}
+	return true;
+}
+
+template<typename T>
+inline bool CheckpointFile::write(const std::string& path, const uint64_t& nodeX, const uint64_t& nodeY,
+		const uint64_t& itterCnt, const prec_t& residual, const T* values, const uint8_t* mask)
+{
+	const uint64_t cells = nodeX * nodeY;
+	CheckpointHeader head;
+	std::memset(&head, 0, sizeof(head));
+	std::memcpy(head.magic, checkpointMagic, sizeof(checkpointMagic));
+	head.version = CheckpointFile::version;
+	head.byteOrder = 0x01020304;
+	head.valueSize = sizeof(T);
+	head.valueDigits = std::numeric_limits<T>::digits;
+	head.nodeX = nodeX;
+	head.nodeY = nodeY;
+	head.itterCnt = itterCnt;
+	head.residual = static_cast<double>(residual);
+	head.valueOffset = alignCheckpointOffset(sizeof(head));
+	head.maskOffset = alignCheckpointOffset(head.valueOffset + cells * sizeof(T));
+
+	const std::string partial = path + ".partial";
+	const int fd = ::open(partial.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0)
+		return false;
+	const char padding[64] = {0};
+	bool isWritten = CheckpointFile::writeAll(fd, &head, sizeof(head)) &&
+		CheckpointFile::writeAll(fd, padding, head.valueOffset - sizeof(head)) &&
+		CheckpointFile::writeAll(fd, values, cells * sizeof(T)) &&
+		CheckpointFile::writeAll(fd, padding, head.maskOffset - head.valueOffset - cells * sizeof(T)) &&
+		CheckpointFile::writeAll(fd, mask, cells);
+	isWritten = ::close(fd) == 0 && isWritten;
+	if (!isWritten || std::rename(partial.c_str(), path.c_str()) != 0) {
+		std::remove(partial.c_str());
+		return false;
+	}
+	return true;
+}
+
+}
+
+#endif
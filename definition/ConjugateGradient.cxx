@@ -0,0 +1,185 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+#ifndef CONJUGATE_GRADIENT_CXX
+#define CONJUGATE_GRADIENT_CXX
+
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+
+#include "../header/ConjugateGradient.h"
+
+namespace HMT
+{
+
+template<typename T>
+ConjugateGradient<T>::ConjugateGradient(const uint64_t& nodeX, const uint64_t& nodeY, const uint8_t* isFixed):
+	_nodeX(nodeX), _nodeY(nodeY), _isFixed(nodeX * nodeY, 1), _preconditioner(Preconditioner::SSOR), _omega(1),
+	_control(nullptr)
+{
+	// fold the walls into the mask so every loop below only has to ask one question
+	for (uint64_t i = 1; i + 1 < nodeY; ++i)
+		for (uint64_t j = 1; j + 1 < nodeX; ++j)
+			this->_isFixed[i * nodeX + j] = isFixed[i * nodeX + j];
+}
+
+template<typename T>
+void ConjugateGradient<T>::setPreconditioner(const Preconditioner preconditioner, const prec_t& omega) noexcept(true)
+{
+	this->_preconditioner = preconditioner;
+	this->_omega = omega;
+}
+
+template<typename T>
+void ConjugateGradient<T>::setSolveControl(SolveControl* control) noexcept(true)
+{
+	this->_control = control;
+}
+
+template<typename T>
+const std::vector<prec_t>& ConjugateGradient<T>::getResidualHistory(void) const noexcept(true)
+{
+	return this->_residualHistory;
+}
+
+template<typename T>
+uint64_t ConjugateGradient<T>::solve(T* grid, const prec_t& epsilon)
+{
+	const uint64_t size = this->_nodeX * this->_nodeY;
+	std::vector<T> r(size, 0), z(size, 0), p(size, 0), q(size, 0);
+	uint64_t itterCnt = 0;
+	this->_residualHistory.clear();
+
+	prec_t norm = this->trueResidual(grid, r.data());
+	while (epsilon <= norm) {
+		// (re)start from the true residual, the recurrence drifts in finite precision
+		this->precondition(r.data(), z.data());
+		std::copy(z.begin(), z.end(), p.begin());
+		prec_t rz = this->dot(r.data(), z.data());
+
+		while (epsilon <= norm && rz > 0) {
+			++itterCnt;
+			this->applyOperator(p.data(), q.data());
+			const prec_t alpha = rz / this->dot(p.data(), q.data());
+			for (uint64_t k = 0; k < size; ++k) {
+				grid[k] += static_cast<T>(alpha * p[k]);
+				r[k] -= static_cast<T>(alpha * q[k]);
+			}
+			norm = std::sqrt(this->dot(r.data(), r.data())) / 4;
+			this->_residualHistory.push_back(norm);
+			if (norm < epsilon)
+				break;
+			if (this->_control && this->_control->poll(itterCnt, norm))
+				return itterCnt;
+
+			this->precondition(r.data(), z.data());
+			const prec_t rzNew = this->dot(r.data(), z.data());
+			const prec_t beta = rzNew / rz;
+			rz = rzNew;
+			for (uint64_t k = 0; k < size; ++k)
+				p[k] = z[k] + static_cast<T>(beta * p[k]);
+		}
+		norm = this->trueResidual(grid, r.data());
+		if (rz <= 0)
+			break;
+	}
+	return itterCnt;
+}
+
+template<typename T>
+void ConjugateGradient<T>::applyOperator(const T* p, T* out) const
+{
+	// p is zero on every fixed node, so they drop out of the stencil
+	const uint64_t nx = this->_nodeX;
+	for (uint64_t i = 1; i + 1 < this->_nodeY; ++i) {
+		for (uint64_t j = 1; j + 1 < nx; ++j) {
+			const uint64_t k = i * nx + j;
+			out[k] = this->_isFixed[k] ? static_cast<T>(0) : 4 * p[k] - p[k - nx] - p[k + nx] - p[k - 1] - p[k + 1];
+		}
+	}
+}
+
+template<typename T>
+prec_t ConjugateGradient<T>::trueResidual(const T* grid, T* r) const
+{
+	const uint64_t nx = this->_nodeX;
+	for (uint64_t i = 1; i + 1 < this->_nodeY; ++i) {
+		for (uint64_t j = 1; j + 1 < nx; ++j) {
+			const uint64_t k = i * nx + j;
+			r[k] = this->_isFixed[k] ? static_cast<T>(0) :
+				grid[k - nx] + grid[k + nx] + grid[k - 1] + grid[k + 1] - 4 * grid[k];
+		}
+	}
+	return std::sqrt(this->dot(r, r)) / 4;
+}
+
+template<typename T>
+void ConjugateGradient<T>::precondition(const T* r, T* z) const
+{
+	const uint64_t nx = this->_nodeX;
+	const uint64_t size = nx * this->_nodeY;
+	if (this->_preconditioner == Preconditioner::None) {
+		std::copy(r, r + size, z);
+	} else if (this->_preconditioner == Preconditioner::Jacobi) {
+		for (uint64_t k = 0; k < size; ++k)
+			z[k] = r[k] / 4;
+	} else {
+		// M = (D + wL) D^-1 (D + wU) / (w (2 - w)) with D = 4 and L, U the -1 couplings
+		const T w = static_cast<T>(this->_omega);
+		for (uint64_t k = 0; k < size; ++k)
+			z[k] = 0;
+		for (uint64_t i = 1; i + 1 < this->_nodeY; ++i) {
+			for (uint64_t j = 1; j + 1 < nx; ++j) {
+				const uint64_t k = i * nx + j;
+				if (!this->_isFixed[k])
+					z[k] = (w * (2 - w) * r[k] + w * (z[k - 1] + z[k - nx])) / 4;
+			}
+		}
+		for (uint64_t k = 0; k < size; ++k)
+			z[k] *= 4;
+		for (uint64_t i = this->_nodeY - 2; i >= 1; --i) {
+			for (uint64_t j = nx - 2; j >= 1; --j) {
+				const uint64_t k = i * nx + j;
+				if (!this->_isFixed[k])
+					z[k] = (z[k] + w * (z[k + 1] + z[k + nx])) / 4;
+			}
+		}
+	}
+}
+
+template<typename T>
+prec_t ConjugateGradient<T>::dot(const T* a, const T* b) const
+{
+	prec_t sum = 0;
+	const uint64_t size = this->_nodeX * this->_nodeY;
+	for (uint64_t k = 0; k < size; ++k)
+		sum += static_cast<prec_t>(a[k]) * b[k];
+	return sum;
+}
+
+}
+
+#endif
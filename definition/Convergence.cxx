@@ -0,0 +1,82 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+#ifndef CONVERGENCE_CXX
+#define CONVERGENCE_CXX
+
+#include <chrono>
+#include <cmath>
+
+#include "../header/Convergence.h"
+
+namespace HMT
+{
+
+inline ConvergenceCheck::ConvergenceCheck(const ConvergencePolicy& policy, const prec_t& epsilon):
+	_policy(policy), _epsilon(epsilon), _reference(0.0f),
+	_startTime(std::chrono::high_resolution_clock::now())
+{
+	if (this->_policy.checkEvery == 0)
+		this->_policy.checkEvery = 1;
+}
+
+inline bool ConvergenceCheck::isCheckSweep(const uint64_t& itterCnt) const noexcept(true)
+{
+	// the last sweep the budget allows is always measured, so its residual is known
+	return itterCnt % this->_policy.checkEvery == 0 || itterCnt == this->_policy.maxItterations;
+}
+
+inline prec_t ConvergenceCheck::norm(const prec_t& measured) noexcept(true)
+{
+	if (this->_policy.norm == Norm::LInf)
+		return measured;
+	const prec_t l2 = std::sqrt(measured);
+	if (this->_policy.norm == Norm::L2)
+		return l2;
+	if (this->_reference == 0)
+		this->_reference = l2;
+	return this->_reference > 0 ? l2 / this->_reference : 0.0f;
+}
+
+inline bool ConvergenceCheck::isConverged(const prec_t& norm) const noexcept(true)
+{
+	return norm < this->_epsilon;
+}
+
+inline bool ConvergenceCheck::isOutOfBudget(const uint64_t& itterCnt) const noexcept(true)
+{
+	if (this->_policy.maxItterations > 0 && itterCnt >= this->_policy.maxItterations)
+		return true;
+	return this->_policy.timeBudget.count() > 0 &&
+		std::chrono::high_resolution_clock::now() - this->_startTime >= this->_policy.timeBudget;
+}
+
+inline Norm ConvergenceCheck::getNorm(void) const noexcept(true)
+{
+	return this->_policy.norm;
+}
+
+}
+
+#endif
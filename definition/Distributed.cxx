@@ -0,0 +1,226 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+
+#ifndef DISTRIBUTED_CXX
+#define DISTRIBUTED_CXX
+
+#include <atomic>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <ctime>
+#include <chrono>
+#include <new>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#include "../header/Distributed.h"
+
+namespace HMT
+{
+
+namespace
+{
+
+inline uint64_t alignHaloOffset(const uint64_t& bytes, const uint64_t& to) noexcept(true)
+{
+	return (bytes + to - 1) / to * to;
+}
+
+// the waits are process-shared, so no FUTEX_PRIVATE_FLAG
+inline void futexWait(std::atomic<uint32_t>& word, const uint32_t expected, const int64_t& timeoutMs) noexcept(true)
+{
+	const struct timespec timeout = {static_cast<time_t>(timeoutMs / 1000), static_cast<long>(timeoutMs % 1000) * 1000000};
+	::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, &timeout, nullptr, 0);
+}
+
+inline void futexWakeAll(std::atomic<uint32_t>& word) noexcept(true)
+{
+	::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+}
+
+inline ShmHaloExchange::ShmHaloExchange(const unsigned int nofRanks, const uint64_t& rowBytes, const uint64_t& gridBytes):
+	_segment(nullptr), _segmentBytes(0), _rank(0), _nofRanks(nofRanks), _rowBytes(rowBytes),
+	_rowStride(alignHaloOffset(rowBytes, 64)), _exchangeCnt(0)
+{
+	// header | 2 x nofRanks slots | 2 x nofRanks x 2 halo rows | gathered grid, each on a cache line
+	this->_slotOffset = alignHaloOffset(sizeof(Header), 64);
+	this->_haloOffset = this->_slotOffset + 2 * nofRanks * alignHaloOffset(sizeof(Slot), 64);
+	this->_gridOffset = this->_haloOffset + 4 * nofRanks * this->_rowStride;
+	this->_segmentBytes = this->_gridOffset + alignHaloOffset(gridBytes, 64);
+
+	static std::atomic<uint32_t> segmentCnt(0);
+	const std::string name = "/hmt-halo-" + std::to_string(::getpid()) + "-" + std::to_string(segmentCnt++);
+	const int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+	if (fd < 0)
+		return;
+	// the mapping outlives the name, so nothing is left in /dev/shm if a rank dies
+	::shm_unlink(name.c_str());
+	if (::ftruncate(fd, static_cast<off_t>(this->_segmentBytes)) == 0) {
+		void* segment = ::mmap(nullptr, this->_segmentBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		if (segment != MAP_FAILED)
+			this->_segment = segment;
+	}
+	::close(fd);
+	if (!this->_segment)
+		return;
+	Header* header = new (this->_segment) Header;
+	header->arrived.store(0);
+	header->generation.store(0);
+	header->isAborted.store(0);
+	header->nofRanks = nofRanks;
+	header->result = RankResult{0, 0, false};
+}
+
+inline ShmHaloExchange::~ShmHaloExchange()
+{
+	if (this->_segment)
+		::munmap(this->_segment, this->_segmentBytes);
+}
+
+inline bool ShmHaloExchange::isOpen(void) const noexcept(true)
+{
+	return this->_segment != nullptr;
+}
+
+inline void ShmHaloExchange::setRank(const unsigned int rank) noexcept(true)
+{
+	this->_rank = rank;
+}
+
+inline void ShmHaloExchange::abort(void) noexcept(true)
+{
+	Header* header = static_cast<Header*>(this->_segment);
+	header->isAborted.store(1);
+	// a waiter that already read the old generation must see it move
+	header->generation.fetch_add(1);
+	futexWakeAll(header->generation);
+}
+
+inline unsigned int ShmHaloExchange::rank(void) const noexcept(true)
+{
+	return this->_rank;
+}
+
+inline unsigned int ShmHaloExchange::size(void) const noexcept(true)
+{
+	return this->_nofRanks;
+}
+
+inline bool ShmHaloExchange::barrier(void) noexcept(true)
+{
+	Header* header = static_cast<Header*>(this->_segment);
+	const uint32_t generation = header->generation.load(std::memory_order_acquire);
+	if (header->arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == this->_nofRanks) {
+		header->arrived.store(0, std::memory_order_relaxed);
+		header->generation.fetch_add(1, std::memory_order_release);
+		futexWakeAll(header->generation);
+		return header->isAborted.load() == 0;
+	}
+	// sweeps are short on small bands, so spin a little before sleeping
+	for (unsigned int spin = 0; spin < 4096; ++spin) {
+		if (header->generation.load(std::memory_order_acquire) != generation)
+			return header->isAborted.load() == 0;
+	}
+	const auto start = std::chrono::steady_clock::now();
+	while (header->generation.load(std::memory_order_acquire) == generation) {
+		futexWait(header->generation, generation, 100);
+		if (std::chrono::steady_clock::now() - start > std::chrono::milliseconds(timeoutMs))
+			return false;
+	}
+	return header->isAborted.load() == 0;
+}
+
+inline ShmHaloExchange::Slot& ShmHaloExchange::slot(const unsigned int parity, const unsigned int rank) const noexcept(true)
+{
+	return *reinterpret_cast<Slot*>(static_cast<char*>(this->_segment) + this->_slotOffset +
+		(parity * this->_nofRanks + rank) * alignHaloOffset(sizeof(Slot), 64));
+}
+
+inline char* ShmHaloExchange::halo(const unsigned int parity, const unsigned int rank,
+		const unsigned int side) const noexcept(true)
+{
+	return static_cast<char*>(this->_segment) + this->_haloOffset +
+		((parity * this->_nofRanks + rank) * 2 + side) * this->_rowStride;
+}
+
+inline bool ShmHaloExchange::exchange(const void* firstRow, const void* lastRow, void* ghostAbove, void* ghostBelow,
+		prec_t& residual, const bool isSum, bool& isOutOfBudget)
+{
+	// a rank can be at most one sweep ahead of the slowest, which reads the other parity
+	const unsigned int parity = this->_exchangeCnt++ & 1;
+	std::memcpy(this->halo(parity, this->_rank, 0), firstRow, this->_rowBytes);
+	std::memcpy(this->halo(parity, this->_rank, 1), lastRow, this->_rowBytes);
+	this->slot(parity, this->_rank).residual = residual;
+	if (this->_rank == 0)
+		this->slot(parity, 0).isOutOfBudget = isOutOfBudget;
+	if (!this->barrier())
+		return false;
+	if (this->_rank > 0)
+		std::memcpy(ghostAbove, this->halo(parity, this->_rank - 1, 1), this->_rowBytes);
+	if (this->_rank + 1 < this->_nofRanks)
+		std::memcpy(ghostBelow, this->halo(parity, this->_rank + 1, 0), this->_rowBytes);
+	// in rank order on every rank, so a SUM comes out the same everywhere
+	residual = 0.0f;
+	for (unsigned int i = 0; i < this->_nofRanks; ++i)
+		residual = isSum ? residual + this->slot(parity, i).residual : std::max(residual, this->slot(parity, i).residual);
+	isOutOfBudget = this->slot(parity, 0).isOutOfBudget;
+	return true;
+}
+
+inline bool ShmHaloExchange::gather(const void* band, const uint64_t& offset, const uint64_t& bytes,
+		const RankResult& result)
+{
+	std::memcpy(static_cast<char*>(this->_segment) + this->_gridOffset + offset, band, bytes);
+	if (this->_rank == 0)
+		static_cast<Header*>(this->_segment)->result = result;
+	return true;
+}
+
+inline const void* ShmHaloExchange::grid(void) const noexcept(true)
+{
+	return static_cast<const char*>(this->_segment) + this->_gridOffset;
+}
+
+inline uint64_t ShmHaloExchange::segmentBytes(void) const noexcept(true)
+{
+	return this->_segmentBytes;
+}
+
+inline RankResult ShmHaloExchange::result(void) const noexcept(true)
+{
+	return static_cast<const Header*>(this->_segment)->result;
+}
+
+}
+
+#endif
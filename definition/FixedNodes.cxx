@@ -0,0 +1,186 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+
+#ifndef FIXED_NODES_CXX
+#define FIXED_NODES_CXX
+
+#include <iostream>
+#include <array>
+#include <utility>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "../header/FixedNodes.h"
+
+namespace HMT
+{
+
+template<typename T, uint64_t NX, uint64_t NY>
+FixedNodes<T, NX, NY>::FixedNodes(void) noexcept(true): _itterCnt(0), _maxItterations(0),
+	_hasCalculated(false), _hasConverged(false)
+{
+	this->_nodes.fill(0);
+	this->_isHeatSource.fill(0);
+}
+
+template<typename T, uint64_t NX, uint64_t NY>
+void FixedNodes<T, NX, NY>::setWallTemp(const T& northTemp, const T& eastTemp, const T& southTemp,
+		const T& westTemp) noexcept(true)
+{
+	this->_hasCalculated = false;
+	for (uint64_t i = 0; i < NY; ++i) {
+		this->_nodes[index(0, i)] = westTemp;
+		this->_nodes[index(NX - 1, i)] = eastTemp;
+	}
+	for (uint64_t i = 0; i < NX; ++i) {
+		this->_nodes[index(i, 0)] = northTemp;
+		this->_nodes[index(i, NY - 1)] = southTemp;
+	}
+	// the starting guess Nodes<T> uses, so both take the same sweeps
+	for (uint64_t i = 1; i < NY - 1; ++i) {
+		for (uint64_t j = 1; j < NX - 1; ++j) {
+			if (!this->_isHeatSource[index(j, i)])
+				this->_nodes[index(j, i)] = (northTemp + eastTemp + southTemp + westTemp) / 4;
+		}
+	}
+}
+
+template<typename T, uint64_t NX, uint64_t NY>
+void FixedNodes<T, NX, NY>::setHeatSource(const uint64_t& posX, const uint64_t& posY, const T& temp) noexcept(true)
+{
+	this->_hasCalculated = false;
+	this->_nodes[index(posX, posY)] = temp;
+	this->_isHeatSource[index(posX, posY)] = 1;
+}
+
+template<typename T, uint64_t NX, uint64_t NY>
+void FixedNodes<T, NX, NY>::setMaxItterations(const uint64_t& maxItterations) noexcept(true)
+{
+	this->_hasCalculated = false;
+	this->_maxItterations = maxItterations;
+}
+
+template<typename T, uint64_t NX, uint64_t NY>
+__attribute__((always_inline))
+inline T FixedNodes<T, NX, NY>::sweepNode(const T* src, T* dst, const uint8_t* isHeatSource,
+		const uint64_t k) noexcept(true)
+{
+	// the Kernels::jacobiRow expression, term for term, so the result matches Nodes<T>
+	const T temp = (src[k - NX] + src[k + NX] + src[k - 1] + src[k + 1]) / 4;
+	dst[k] = isHeatSource[k] ? src[k] : temp;
+	return std::fabs(src[k] - dst[k]);
+}
+
+template<typename T, uint64_t NX, uint64_t NY> template<std::size_t... J>
+__attribute__((always_inline))
+inline T FixedNodes<T, NX, NY>::sweepRow(const T* src, T* dst, const uint8_t* isHeatSource,
+		std::index_sequence<J...>) noexcept(true)
+{
+	// one statement per interior node, each at a constant offset from the row
+	T diff = 0;
+	const int expand[] = {0, (diff = std::max<T>(diff, sweepNode(src, dst, isHeatSource, J + 1)), 0)...};
+	static_cast<void>(expand);
+	return diff;
+}
+
+template<typename T, uint64_t NX, uint64_t NY>
+prec_t FixedNodes<T, NX, NY>::sweep(const T* src, T* dst, const uint8_t* isHeatSource) noexcept(true)
+{
+	prec_t diff = 0.0f;
+	for (uint64_t i = 1; i < NY - 1; ++i) {
+		const uint64_t row = index(0, i);
+		if (NX - 2 <= maxUnrolledRow) {
+			diff = std::max<prec_t>(diff, sweepRow(src + row, dst + row, isHeatSource + row,
+				std::make_index_sequence<(NX - 2 <= maxUnrolledRow ? NX - 2 : 0)>()));
+		} else {
+			// too long to expand; the vector kernels round exactly like the expansion
+			diff = std::max(diff, Kernels::jacobiRow(src + row - NX, src + row, src + row + NX,
+				isHeatSource + row, dst + row, 1, NX - 1));
+		}
+	}
+	return diff;
+}
+
+template<typename T, uint64_t NX, uint64_t NY>
+void FixedNodes<T, NX, NY>::calculate(const prec_t epsilon) noexcept(true)
+{
+	if (this->_hasCalculated)
+		return;
+	// walls and heat sources are never written by a sweep, so after this both generations hold them
+	this->_nodesOld = this->_nodes;
+	T* src = this->_nodes.data();
+	T* dst = this->_nodesOld.data();
+	this->_itterCnt = 0;
+	this->_hasConverged = true;
+	while (true) {
+		++(this->_itterCnt);
+		const prec_t diff = sweep(src, dst, this->_isHeatSource.data());
+		std::swap(src, dst);
+		if (diff < epsilon)
+			break;
+		if (this->_maxItterations > 0 && this->_itterCnt >= this->_maxItterations) {
+			this->_hasConverged = false;
+			break;
+		}
+	}
+	// the newest generation sits in _nodesOld after an odd number of sweeps
+	if (src != this->_nodes.data())
+		this->_nodes = this->_nodesOld;
+	this->_hasCalculated = true;
+}
+
+template<typename T, uint64_t NX, uint64_t NY>
+bool FixedNodes<T, NX, NY>::hasConverged(void) const noexcept(true)
+{
+	return this->_hasConverged;
+}
+
+template<typename T, uint64_t NX, uint64_t NY>
+T FixedNodes<T, NX, NY>::getTemp(const uint64_t& posX, const uint64_t& posY) const noexcept(true)
+{
+	return this->_hasCalculated ? this->_nodes[index(posX, posY)] : 0;
+}
+
+template<typename T, uint64_t NX, uint64_t NY>
+uint64_t FixedNodes<T, NX, NY>::getItterCount(void) const noexcept(true)
+{
+	return this->_itterCnt;
+}
+
+template<typename T, uint64_t NX, uint64_t NY>
+std::ostream& operator<<(std::ostream& os, const FixedNodes<T, NX, NY>& obj)
+{
+	for (uint64_t i = 0; i < NY; ++i) {
+		for (uint64_t j = 0; j < NX; ++j)
+			os << obj._nodes[obj.index(j, i)] << ", ";
+		os << '\n';
+	}
+	return os;
+}
+
+}
+
+#endif
@@ -0,0 +1,208 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+
+#ifndef GRID_MEMORY_CXX
+#define GRID_MEMORY_CXX
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <sched.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "../header/GridMemory.h"
+
+namespace HMT
+{
+
+namespace GridMemoryDetail
+{
+
+struct State
+{
+	std::atomic<int> hugePages{static_cast<int>(HugePages::Off)};
+	std::atomic<bool> firstTouch{false}, pinWorkers{false};
+	std::atomic<unsigned int> colour{0};
+	std::atomic<uint64_t> mappedBytes{0}, transparentBytes{0}, explicitBytes{0}, fallbacks{0}, placedBytes{0};
+};
+
+// one per process, an inline function's static is shared by every translation unit
+inline State& state(void) noexcept(true)
+{
+	static State instance;
+	return instance;
+}
+
+inline std::size_t roundUp(const std::size_t& bytes) noexcept(true)
+{
+	return (bytes + GridMemory::hugePageSize - 1) / GridMemory::hugePageSize * GridMemory::hugePageSize;
+}
+
+}
+
+inline void GridMemory::setPolicy(const GridMemoryPolicy& policy) noexcept(true)
+{
+	GridMemoryDetail::State& state = GridMemoryDetail::state();
+	state.hugePages = static_cast<int>(policy.hugePages);
+	state.firstTouch = policy.firstTouch;
+	state.pinWorkers = policy.pinWorkers;
+}
+
+inline GridMemoryPolicy GridMemory::getPolicy(void) noexcept(true)
+{
+	const GridMemoryDetail::State& state = GridMemoryDetail::state();
+	GridMemoryPolicy policy;
+	policy.hugePages = static_cast<HugePages>(state.hugePages.load());
+	policy.firstTouch = state.firstTouch;
+	policy.pinWorkers = state.pinWorkers;
+	return policy;
+}
+
+inline GridMemoryStats GridMemory::getStats(void) noexcept(true)
+{
+	const GridMemoryDetail::State& state = GridMemoryDetail::state();
+	return GridMemoryStats{state.mappedBytes, state.transparentBytes, state.explicitBytes,
+		state.fallbacks, state.placedBytes};
+}
+
+inline bool GridMemory::isMapped(const std::size_t& bytes) noexcept(true)
+{
+	return bytes >= mapThreshold;
+}
+
+inline void* GridMemory::map(const std::size_t& bytes) noexcept(true)
+{
+	GridMemoryDetail::State& state = GridMemoryDetail::state();
+	const std::size_t offset = colourStride * (state.colour++ % colours);
+	const std::size_t length = GridMemoryDetail::roundUp(bytes + offset);
+	const HugePages hugePages = getPolicy().hugePages;
+	if (hugePages == HugePages::Explicit) {
+		void* ptr = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		if (ptr != MAP_FAILED) {
+			state.mappedBytes += length;
+			state.explicitBytes += length;
+			return static_cast<char*>(ptr) + offset;
+		}
+		// no reserved pages (vm.nr_hugepages) or not enough of them left
+		++state.fallbacks;
+	}
+	// one spare huge page of slack, then cut the mapping down to an aligned run
+	void* raw = ::mmap(nullptr, length + hugePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (raw == MAP_FAILED)
+		return nullptr;
+	char* begin = static_cast<char*>(raw);
+	char* aligned = begin + (hugePageSize - reinterpret_cast<uintptr_t>(begin) % hugePageSize) % hugePageSize;
+	if (aligned > begin)
+		::munmap(begin, aligned - begin);
+	if (aligned < begin + hugePageSize)
+		::munmap(aligned + length, begin + hugePageSize - aligned);
+	state.mappedBytes += length;
+	// THP set to never, or a kernel without it
+	if (hugePages != HugePages::Off) {
+		if (::madvise(aligned, length, MADV_HUGEPAGE) != 0)
+			++state.fallbacks;
+		else
+			state.transparentBytes += length;
+	}
+	return aligned + offset;
+}
+
+inline void GridMemory::unmap(void* ptr, const std::size_t& bytes) noexcept(true)
+{
+	// every mapping starts on a huge page, the block a colour further in
+	char* base = reinterpret_cast<char*>(reinterpret_cast<uintptr_t>(ptr) / hugePageSize * hugePageSize);
+	::munmap(base, GridMemoryDetail::roundUp(bytes + (static_cast<char*>(ptr) - base)));
+}
+
+inline uint64_t GridMemory::place(void* ptr, const std::size_t& bytes) noexcept(true)
+{
+	const uintptr_t first = reinterpret_cast<uintptr_t>(ptr);
+	const uintptr_t begin = GridMemoryDetail::roundUp(first);
+	const uintptr_t end = (first + bytes) / hugePageSize * hugePageSize;
+	if (end <= begin)
+		return 0;
+	char* buffer = static_cast<char*>(std::malloc(hugePageSize));
+	if (!buffer)
+		return 0;
+	uint64_t placed = 0;
+	for (uintptr_t page = begin; page < end; page += hugePageSize) {
+		char* data = reinterpret_cast<char*>(page);
+		std::memcpy(buffer, data, hugePageSize);
+		// the old frames go back to the kernel, the copy below faults new ones here
+		if (::madvise(data, hugePageSize, MADV_DONTNEED) != 0)
+			break;
+		std::memcpy(data, buffer, hugePageSize);
+		placed += hugePageSize;
+	}
+	std::free(buffer);
+	GridMemoryDetail::state().placedBytes += placed;
+	return placed;
+}
+
+inline bool GridMemory::pinThread(const unsigned int slot) noexcept(true)
+{
+	// the process mask, a thread pinned earlier only sees its own CPU
+	cpu_set_t allowed;
+	CPU_ZERO(&allowed);
+	if (::sched_getaffinity(::getpid(), sizeof(allowed), &allowed) != 0 || CPU_COUNT(&allowed) == 0)
+		return false;
+	unsigned int remaining = slot % CPU_COUNT(&allowed);
+	for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+		if (!CPU_ISSET(cpu, &allowed) || remaining-- > 0)
+			continue;
+		cpu_set_t one;
+		CPU_ZERO(&one);
+		CPU_SET(cpu, &one);
+		return ::pthread_setaffinity_np(::pthread_self(), sizeof(one), &one) == 0;
+	}
+	return false;
+}
+
+inline int64_t GridMemory::residentHugeBytes(void)
+{
+	std::ifstream file("/proc/self/smaps_rollup");
+	if (!file.is_open())
+		return -1;
+	int64_t bytes = 0;
+	std::string line;
+	while (std::getline(file, line)) {
+		std::istringstream fields(line);
+		std::string name;
+		int64_t kiloBytes = 0;
+		fields >> name >> kiloBytes;
+		if (name == "AnonHugePages:" || name == "Shared_Hugetlb:" || name == "Private_Hugetlb:")
+			bytes += kiloBytes << 10;
+	}
+	return bytes;
+}
+
+}
+
+#endif
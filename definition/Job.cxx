@@ -0,0 +1,215 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+#ifndef JOB_CXX
+#define JOB_CXX
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "../header/Job.h"
+
+namespace HMT
+{
+
+template<typename T>
+bool JobFile::load(const std::string& path, std::vector<JobSpec<T>>& jobs, std::string& error)
+{
+	std::ifstream file(path);
+	if (!file) {
+		error = path + ": cannot open";
+		return false;
+	}
+	if (!JobFile::parse(file, jobs, error)) {
+		error = path + ": " + error;
+		return false;
+	}
+	return true;
+}
+
+template<typename T>
+bool JobFile::parse(std::istream& in, std::vector<JobSpec<T>>& jobs, std::string& error)
+{
+	std::vector<JobSpec<T>> parsed;
+	JobSpec<T> defaults;
+	std::string line;
+	uint64_t lineNo = 0;
+	while (std::getline(in, line)) {
+		++lineNo;
+		line = JobFile::trim(line.substr(0, line.find('#')));
+		if (line.empty())
+			continue;
+		if (line == "[job]") {
+			parsed.push_back(defaults);
+			if (parsed.back().name.empty())
+				parsed.back().name = "job" + std::to_string(parsed.size());
+			continue;
+		}
+		const std::string::size_type split = line.find('=');
+		if (split == std::string::npos) {
+			error = "line " + std::to_string(lineNo) + ": expected key = value";
+			return false;
+		}
+		std::istringstream value(JobFile::trim(line.substr(split + 1)));
+		JobSpec<T>& job = parsed.empty() ? defaults : parsed.back();
+		if (!JobFile::setKey(job, JobFile::trim(line.substr(0, split)), value, error)) {
+			error = "line " + std::to_string(lineNo) + ": " + error;
+			return false;
+		}
+	}
+	// a file without any [job] line is a single job
+	if (parsed.empty()) {
+		parsed.push_back(defaults);
+		if (parsed.back().name.empty())
+			parsed.back().name = "job1";
+	}
+	jobs.insert(jobs.end(), parsed.begin(), parsed.end());
+	return true;
+}
+
+template<typename T>
+std::string JobFile::validate(const JobSpec<T>& job)
+{
+	if (job.dX == 0 || job.dY == 0)
+		return "spacing must be positive";
+	const uint64_t nodeX = job.lenX / job.dX, nodeY = job.lenY / job.dY;
+	if (nodeX < 3 || nodeY < 3)
+		return "plate needs at least 3x3 nodes, length / spacing gives " +
+			std::to_string(nodeX) + "x" + std::to_string(nodeY);
+	for (const auto& i : job.heatSources) {
+		if (i.first.first >= nodeX || i.first.second >= nodeY)
+			return "heat source (" + std::to_string(i.first.first) + ", " + std::to_string(i.first.second) +
+				") is off the plate";
+	}
+	if (!(job.epsilon > 0))
+		return "epsilon must be positive";
+	return "";
+}
+
+template<typename T>
+bool JobFile::setKey(JobSpec<T>& job, const std::string& key, std::istringstream& value, std::string& error)
+{
+	std::string word;
+	if (key == "name") {
+		job.name = value.str();
+		return true;
+	} else if (key == "output") {
+		job.outputPath = value.str();
+		return true;
+	} else if (key == "length") {
+		value >> job.lenX >> job.lenY;
+	} else if (key == "spacing") {
+		value >> job.dX >> job.dY;
+	} else if (key == "walls") {
+		value >> job.tempNorth >> job.tempEast >> job.tempSouth >> job.tempWest;
+	} else if (key == "heatSource") {
+		std::pair<std::pair<uint64_t, uint64_t>, T> source;
+		value >> source.first.first >> source.first.second >> source.second;
+		if (value)
+			job.heatSources.push_back(source);
+	} else if (key == "epsilon") {
+		value >> job.epsilon;
+	} else if (key == "threads") {
+		value >> job.threadCnt;
+	} else if (key == "precision") {
+		value >> job.precision;
+	} else if (key == "solver") {
+		value >> word;
+		if (!JobFile::parseSolverMode(word, job.solverMode)) {
+			error = "unknown solver '" + word + "'";
+			return false;
+		}
+	} else if (key == "format") {
+		value >> word;
+		if (!JobFile::parseFormat(word, job.outputFormat)) {
+			error = "unknown format '" + word + "'";
+			return false;
+		}
+	} else {
+		error = "unknown key '" + key + "'";
+		return false;
+	}
+	// every value read and nothing left behind it
+	if (!value || !(value >> std::ws).eof()) {
+		error = "bad value for '" + key + "'";
+		return false;
+	}
+	return true;
+}
+
+inline bool JobFile::parseSolverMode(const std::string& name, SolverMode& mode) noexcept(true)
+{
+	if (name == "jacobi")
+		mode = SolverMode::Jacobi;
+	else if (name == "sor")
+		mode = SolverMode::RedBlackSOR;
+	else if (name == "multigrid")
+		mode = SolverMode::Multigrid;
+	else if (name == "cg")
+		mode = SolverMode::ConjugateGradient;
+	else if (name == "tiled")
+		mode = SolverMode::TiledJacobi;
+	else if (name == "mixed")
+		mode = SolverMode::MixedPrecision;
+	else if (name == "adi")
+		mode = SolverMode::ADI;
+	else if (name == "distributed")
+		mode = SolverMode::Distributed;
+	else if (name == "inplace")
+		mode = SolverMode::InPlace;
+	else if (name == "outofcore")
+		mode = SolverMode::OutOfCore;
+	else
+		return false;
+	return true;
+}
+
+inline bool JobFile::parseFormat(const std::string& name, ResultFormat& format) noexcept(true)
+{
+	if (name == "csv")
+		format = ResultFormat::Csv;
+	else if (name == "raw")
+		format = ResultFormat::Raw;
+	else if (name == "vtk")
+		format = ResultFormat::Vtk;
+	else
+		return false;
+	return true;
+}
+
+inline std::string JobFile::trim(const std::string& text)
+{
+	const std::string::size_type first = text.find_first_not_of(" \t\r\n");
+	if (first == std::string::npos)
+		return "";
+	return text.substr(first, text.find_last_not_of(" \t\r\n") - first + 1);
+}
+
+}
+
+#endif
@@ -0,0 +1,144 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+#ifndef JOB_RUNNER_CXX
+#define JOB_RUNNER_CXX
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+
+#include "../header/JobRunner.h"
+
+namespace HMT
+{
+
+template<typename T>
+JobRunner<T>::JobRunner(std::ostream& log): _log(log)
+{ }
+
+template<typename T>
+bool JobRunner<T>::enqueue(const std::string& path)
+{
+	std::vector<JobSpec<T>> jobs;
+	std::string error;
+	if (!JobFile::load(path, jobs, error)) {
+		this->_log << "{\"file\":" << quote(path) << ",\"status\":\"invalid\",\"error\":" << quote(error)
+			<< "}\n" << std::flush;
+		return false;
+	}
+	this->_queue.insert(this->_queue.end(), jobs.begin(), jobs.end());
+	return true;
+}
+
+template<typename T>
+void JobRunner<T>::enqueue(const JobSpec<T>& job)
+{
+	this->_queue.push_back(job);
+}
+
+template<typename T>
+uint64_t JobRunner<T>::size(void) const noexcept(true)
+{
+	return this->_queue.size();
+}
+
+template<typename T>
+uint64_t JobRunner<T>::run(void)
+{
+	uint64_t failCnt = 0;
+	while (!this->_queue.empty()) {
+		if (!this->runOne(this->_queue.front()))
+			++failCnt;
+		this->_queue.pop_front();
+	}
+	return failCnt;
+}
+
+template<typename T>
+bool JobRunner<T>::runOne(const JobSpec<T>& job)
+{
+	const std::string error = JobFile::validate(job);
+	if (!error.empty()) {
+		this->_log << "{\"job\":" << quote(job.name) << ",\"status\":\"invalid\",\"error\":" << quote(error)
+			<< "}\n" << std::flush;
+		return false;
+	}
+
+	typedef std::chrono::high_resolution_clock clock;
+	const clock::time_point setupStart = clock::now();
+	NodesHelper<T> helper;
+	helper.init(job);
+	const clock::time_point solveStart = clock::now();
+	helper.calculate(job.epsilon);
+	const clock::time_point writeStart = clock::now();
+	const Nodes<T>& nodes = helper.getNodes();
+	const bool isWritten = job.outputPath.empty() ||
+		nodes.writeResult(job.outputPath, job.outputFormat, job.precision);
+	const clock::time_point end = clock::now();
+
+	const auto ns = [] (const clock::time_point& from, const clock::time_point& to) -> int64_t {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count();
+	};
+	// one write per line, so a scheduler tailing the log never sees half a record
+	std::string line = "{\"job\":" + quote(job.name) +
+		",\"status\":\"" + (isWritten ? "ok" : "failed") + "\"" +
+		",\"nodeX\":" + std::to_string(job.lenX / job.dX) +
+		",\"nodeY\":" + std::to_string(job.lenY / job.dY) +
+		",\"itterations\":" + std::to_string(nodes.getItterCount()) +
+		",\"converged\":" + (nodes.hasConverged() ? "true" : "false") +
+		",\"peakBytes\":" + std::to_string(nodes.getMemoryFootprint().peakBytes) +
+		",\"setupNs\":" + std::to_string(ns(setupStart, solveStart)) +
+		",\"solveNs\":" + std::to_string(ns(solveStart, writeStart)) +
+		",\"writeNs\":" + std::to_string(ns(writeStart, end)) +
+		",\"output\":" + quote(job.outputPath) + "}\n";
+	this->_log << line << std::flush;
+	return isWritten;
+}
+
+template<typename T>
+std::string JobRunner<T>::quote(const std::string& text)
+{
+	std::string quoted = "\"";
+	for (const char c : text) {
+		if (c == '"' || c == '\\') {
+			quoted += '\\';
+			quoted += c;
+		} else if (static_cast<unsigned char>(c) < 0x20) {
+			char escaped[8];
+			std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(c));
+			quoted += escaped;
+		} else {
+			quoted += c;
+		}
+	}
+	return quoted + "\"";
+}
+
+}
+
+#endif
@@ -0,0 +1,353 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+#ifndef KERNELS_CXX
+#define KERNELS_CXX
+
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <atomic>
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HMT_KERNELS_X86 1
+#endif
+
+#include "../header/Kernels.h"
+
+namespace HMT
+{
+
+namespace Kernels
+{
+
+inline std::atomic<SimdIsa>& isaState(void) noexcept(true)
+{
+	static std::atomic<SimdIsa> isa(detectIsa());
+	return isa;
+}
+
+inline SimdIsa detectIsa(void) noexcept(true)
+{
+#ifdef HMT_KERNELS_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+			__builtin_cpu_supports("avx512vl"))
+		return SimdIsa::AVX512;
+	if (__builtin_cpu_supports("avx2"))
+		return SimdIsa::AVX2;
+	if (__builtin_cpu_supports("sse4.1"))
+		return SimdIsa::SSE41;
+#endif
+	return SimdIsa::Scalar;
+}
+
+inline SimdIsa activeIsa(void) noexcept(true)
+{
+	return isaState().load(std::memory_order_relaxed);
+}
+
+inline void setIsa(const SimdIsa isa) noexcept(true)
+{
+	isaState().store(std::min(isa, detectIsa()), std::memory_order_relaxed);
+}
+
+inline const char* isaName(const SimdIsa isa) noexcept(true)
+{
+	switch (isa) {
+	case SimdIsa::AVX512:
+		return "avx512";
+	case SimdIsa::AVX2:
+		return "avx2";
+	case SimdIsa::SSE41:
+		return "sse4.1";
+	default:
+		return "scalar";
+	}
+}
+
+template<bool Residual, typename T>
+inline prec_t jacobiRowScalar(const T* north, const T* row, const T* south, const uint8_t* isFixed,
+	T* out, const uint64_t& begin, const uint64_t& end) noexcept(true)
+{
+	T diff = 0;
+	for (uint64_t j = begin; j < end; ++j) {
+		// select instead of branching so the compiler may still vectorize it
+		const T temp = (north[j] + south[j] + row[j - 1] + row[j + 1]) / 4;
+		out[j] = isFixed[j] ? row[j] : temp;
+		if (Residual)
+			diff = std::max<T>(diff, std::fabs(row[j] - out[j]));
+	}
+	return diff;
+}
+
+template<typename T>
+inline prec_t jacobiRow(const T* north, const T* row, const T* south, const uint8_t* isFixed,
+	T* out, const uint64_t& begin, const uint64_t& end) noexcept(true)
+{
+	return jacobiRowScalar<true>(north, row, south, isFixed, out, begin, end);
+}
+
+template<typename T>
+inline void jacobiRowUpdate(const T* north, const T* row, const T* south, const uint8_t* isFixed,
+	T* out, const uint64_t& begin, const uint64_t& end) noexcept(true)
+{
+	jacobiRowScalar<false>(north, row, south, isFixed, out, begin, end);
+}
+
+#ifdef HMT_KERNELS_X86
+
+/**
+*	the vector paths add in the same order as the scalar loop and scale by
+*	0.25, which is exact, so every lane rounds exactly like the reference;
+*	fixed nodes are blended back from the old row with a mask widened from
+*	the byte flags; the wide paths clear the upper vector state before the
+*	scalar tail, which is built without VEX and stalls on a dirty upper half
+**/
+
+template<bool Residual>
+__attribute__((target("sse4.1")))
+inline prec_t jacobiRowSSE41(const double* north, const double* row, const double* south,
+	const uint8_t* isFixed, double* out, const uint64_t& begin, const uint64_t& end) noexcept(true)
+{
+	const __m128d quarter = _mm_set1_pd(0.25), sign = _mm_set1_pd(-0.0);
+	__m128d diff = _mm_setzero_pd();
+	uint64_t j = begin;
+	for (; j + 2 <= end; j += 2) {
+		const __m128d c = _mm_loadu_pd(row + j);
+		const __m128d temp = _mm_mul_pd(_mm_add_pd(_mm_add_pd(_mm_add_pd(
+			_mm_loadu_pd(north + j), _mm_loadu_pd(south + j)), _mm_loadu_pd(row + j - 1)),
+			_mm_loadu_pd(row + j + 1)), quarter);
+		uint16_t flags;
+		std::memcpy(&flags, isFixed + j, sizeof(flags));
+		const __m128i isFree = _mm_cmpeq_epi64(_mm_cvtepu8_epi64(_mm_cvtsi32_si128(flags)), _mm_setzero_si128());
+		const __m128d value = _mm_blendv_pd(c, temp, _mm_castsi128_pd(isFree));
+		_mm_storeu_pd(out + j, value);
+		if (Residual)
+			diff = _mm_max_pd(diff, _mm_andnot_pd(sign, _mm_sub_pd(value, c)));
+	}
+	double lanes[2];
+	_mm_storeu_pd(lanes, diff);
+	return std::max<prec_t>(std::max(lanes[0], lanes[1]),
+		jacobiRowScalar<Residual>(north, row, south, isFixed, out, j, end));
+}
+
+template<bool Residual>
+__attribute__((target("sse4.1")))
+inline prec_t jacobiRowSSE41(const float* north, const float* row, const float* south,
+	const uint8_t* isFixed, float* out, const uint64_t& begin, const uint64_t& end) noexcept(true)
+{
+	const __m128 quarter = _mm_set1_ps(0.25f), sign = _mm_set1_ps(-0.0f);
+	__m128 diff = _mm_setzero_ps();
+	uint64_t j = begin;
+	for (; j + 4 <= end; j += 4) {
+		const __m128 c = _mm_loadu_ps(row + j);
+		const __m128 temp = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(
+			_mm_loadu_ps(north + j), _mm_loadu_ps(south + j)), _mm_loadu_ps(row + j - 1)),
+			_mm_loadu_ps(row + j + 1)), quarter);
+		uint32_t flags;
+		std::memcpy(&flags, isFixed + j, sizeof(flags));
+		const __m128i isFree = _mm_cmpeq_epi32(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(flags)), _mm_setzero_si128());
+		const __m128 value = _mm_blendv_ps(c, temp, _mm_castsi128_ps(isFree));
+		_mm_storeu_ps(out + j, value);
+		if (Residual)
+			diff = _mm_max_ps(diff, _mm_andnot_ps(sign, _mm_sub_ps(value, c)));
+	}
+	float lanes[4];
+	_mm_storeu_ps(lanes, diff);
+	return std::max<prec_t>(*std::max_element(lanes, lanes + 4),
+		jacobiRowScalar<Residual>(north, row, south, isFixed, out, j, end));
+}
+
+template<bool Residual>
+__attribute__((target("avx2")))
+inline prec_t jacobiRowAVX2(const double* north, const double* row, const double* south,
+	const uint8_t* isFixed, double* out, const uint64_t& begin, const uint64_t& end) noexcept(true)
+{
+	const __m256d quarter = _mm256_set1_pd(0.25), sign = _mm256_set1_pd(-0.0);
+	__m256d diff = _mm256_setzero_pd();
+	uint64_t j = begin;
+	for (; j + 4 <= end; j += 4) {
+		const __m256d c = _mm256_loadu_pd(row + j);
+		const __m256d temp = _mm256_mul_pd(_mm256_add_pd(_mm256_add_pd(_mm256_add_pd(
+			_mm256_loadu_pd(north + j), _mm256_loadu_pd(south + j)), _mm256_loadu_pd(row + j - 1)),
+			_mm256_loadu_pd(row + j + 1)), quarter);
+		uint32_t flags;
+		std::memcpy(&flags, isFixed + j, sizeof(flags));
+		const __m256i isFree = _mm256_cmpeq_epi64(_mm256_cvtepu8_epi64(_mm_cvtsi32_si128(flags)),
+			_mm256_setzero_si256());
+		const __m256d value = _mm256_blendv_pd(c, temp, _mm256_castsi256_pd(isFree));
+		_mm256_storeu_pd(out + j, value);
+		if (Residual)
+			diff = _mm256_max_pd(diff, _mm256_andnot_pd(sign, _mm256_sub_pd(value, c)));
+	}
+	double lanes[4];
+	_mm256_storeu_pd(lanes, diff);
+	_mm256_zeroupper();
+	return std::max<prec_t>(*std::max_element(lanes, lanes + 4),
+		jacobiRowScalar<Residual>(north, row, south, isFixed, out, j, end));
+}
+
+template<bool Residual>
+__attribute__((target("avx2")))
+inline prec_t jacobiRowAVX2(const float* north, const float* row, const float* south,
+	const uint8_t* isFixed, float* out, const uint64_t& begin, const uint64_t& end) noexcept(true)
+{
+	const __m256 quarter = _mm256_set1_ps(0.25f), sign = _mm256_set1_ps(-0.0f);
+	__m256 diff = _mm256_setzero_ps();
+	uint64_t j = begin;
+	for (; j + 8 <= end; j += 8) {
+		const __m256 c = _mm256_loadu_ps(row + j);
+		const __m256 temp = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+			_mm256_loadu_ps(north + j), _mm256_loadu_ps(south + j)), _mm256_loadu_ps(row + j - 1)),
+			_mm256_loadu_ps(row + j + 1)), quarter);
+		const __m256i isFree = _mm256_cmpeq_epi32(
+			_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(isFixed + j))),
+			_mm256_setzero_si256());
+		const __m256 value = _mm256_blendv_ps(c, temp, _mm256_castsi256_ps(isFree));
+		_mm256_storeu_ps(out + j, value);
+		if (Residual)
+			diff = _mm256_max_ps(diff, _mm256_andnot_ps(sign, _mm256_sub_ps(value, c)));
+	}
+	float lanes[8];
+	_mm256_storeu_ps(lanes, diff);
+	_mm256_zeroupper();
+	return std::max<prec_t>(*std::max_element(lanes, lanes + 8),
+		jacobiRowScalar<Residual>(north, row, south, isFixed, out, j, end));
+}
+
+template<bool Residual>
+__attribute__((target("avx512f,avx512bw,avx512vl")))
+inline prec_t jacobiRowAVX512(const double* north, const double* row, const double* south,
+	const uint8_t* isFixed, double* out, const uint64_t& begin, const uint64_t& end) noexcept(true)
+{
+	const __m512d quarter = _mm512_set1_pd(0.25);
+	const __m512i magnitude = _mm512_set1_epi64(0x7fffffffffffffffLL);
+	__m512d diff = _mm512_setzero_pd();
+	uint64_t j = begin;
+	for (; j + 8 <= end; j += 8) {
+		const __m512d c = _mm512_loadu_pd(row + j);
+		const __m512d temp = _mm512_mul_pd(_mm512_add_pd(_mm512_add_pd(_mm512_add_pd(
+			_mm512_loadu_pd(north + j), _mm512_loadu_pd(south + j)), _mm512_loadu_pd(row + j - 1)),
+			_mm512_loadu_pd(row + j + 1)), quarter);
+		const __m128i flags = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(isFixed + j));
+		const __mmask8 fixed = static_cast<__mmask8>(_mm_test_epi8_mask(flags, flags));
+		const __m512d value = _mm512_mask_blend_pd(fixed, temp, c);
+		_mm512_storeu_pd(out + j, value);
+		// the masked form names its pass-through operand, which keeps GCC 12 at -Og quiet
+		if (Residual)
+			diff = _mm512_mask_max_pd(diff, 0xff, diff, _mm512_castsi512_pd(
+				_mm512_and_si512(_mm512_castpd_si512(_mm512_sub_pd(value, c)), magnitude)));
+	}
+	double lanes[8];
+	_mm512_storeu_pd(lanes, diff);
+	_mm256_zeroupper();
+	return std::max<prec_t>(*std::max_element(lanes, lanes + 8),
+		jacobiRowScalar<Residual>(north, row, south, isFixed, out, j, end));
+}
+
+template<bool Residual>
+__attribute__((target("avx512f,avx512bw,avx512vl")))
+inline prec_t jacobiRowAVX512(const float* north, const float* row, const float* south,
+	const uint8_t* isFixed, float* out, const uint64_t& begin, const uint64_t& end) noexcept(true)
+{
+	const __m512 quarter = _mm512_set1_ps(0.25f);
+	const __m512i magnitude = _mm512_set1_epi32(0x7fffffff);
+	__m512 diff = _mm512_setzero_ps();
+	uint64_t j = begin;
+	for (; j + 16 <= end; j += 16) {
+		const __m512 c = _mm512_loadu_ps(row + j);
+		const __m512 temp = _mm512_mul_ps(_mm512_add_ps(_mm512_add_ps(_mm512_add_ps(
+			_mm512_loadu_ps(north + j), _mm512_loadu_ps(south + j)), _mm512_loadu_ps(row + j - 1)),
+			_mm512_loadu_ps(row + j + 1)), quarter);
+		const __m128i flags = _mm_loadu_si128(reinterpret_cast<const __m128i*>(isFixed + j));
+		const __mmask16 fixed = _mm_test_epi8_mask(flags, flags);
+		const __m512 value = _mm512_mask_blend_ps(fixed, temp, c);
+		_mm512_storeu_ps(out + j, value);
+		if (Residual)
+			diff = _mm512_mask_max_ps(diff, 0xffff, diff, _mm512_castsi512_ps(
+				_mm512_and_si512(_mm512_castps_si512(_mm512_sub_ps(value, c)), magnitude)));
+	}
+	float lanes[16];
+	_mm512_storeu_ps(lanes, diff);
+	_mm256_zeroupper();
+	return std::max<prec_t>(*std::max_element(lanes, lanes + 16),
+		jacobiRowScalar<Residual>(north, row, south, isFixed, out, j, end));
+}
+
+#endif
+
+template<bool Residual, typename T>
+inline prec_t jacobiRowDispatch(const T* north, const T* row, const T* south, const uint8_t* isFixed,
+	T* out, const uint64_t& begin, const uint64_t& end) noexcept(true)
+{
+	switch (activeIsa()) {
+#ifdef HMT_KERNELS_X86
+	case SimdIsa::AVX512:
+		return jacobiRowAVX512<Residual>(north, row, south, isFixed, out, begin, end);
+	case SimdIsa::AVX2:
+		return jacobiRowAVX2<Residual>(north, row, south, isFixed, out, begin, end);
+	case SimdIsa::SSE41:
+		return jacobiRowSSE41<Residual>(north, row, south, isFixed, out, begin, end);
+#endif
+	default:
+		return jacobiRowScalar<Residual>(north, row, south, isFixed, out, begin, end);
+	}
+}
+
+template<>
+inline prec_t jacobiRow<float>(const float* north, const float* row, const float* south, const uint8_t* isFixed,
+	float* out, const uint64_t& begin, const uint64_t& end) noexcept(true)
+{
+	return jacobiRowDispatch<true>(north, row, south, isFixed, out, begin, end);
+}
+
+template<>
+inline prec_t jacobiRow<double>(const double* north, const double* row, const double* south, const uint8_t* isFixed,
+	double* out, const uint64_t& begin, const uint64_t& end) noexcept(true)
+{
+	return jacobiRowDispatch<true>(north, row, south, isFixed, out, begin, end);
+}
+
+template<>
+inline void jacobiRowUpdate<float>(const float* north, const float* row, const float* south, const uint8_t* isFixed,
+	float* out, const uint64_t& begin, const uint64_t& end) noexcept(true)
+{
+	jacobiRowDispatch<false>(north, row, south, isFixed, out, begin, end);
+}
+
+template<>
+inline void jacobiRowUpdate<double>(const double* north, const double* row, const double* south, const uint8_t* isFixed,
+	double* out, const uint64_t& begin, const uint64_t& end) noexcept(true)
+{
+	jacobiRowDispatch<false>(north, row, south, isFixed, out, begin, end);
+}
+
+}
+
+}
+
+#endif
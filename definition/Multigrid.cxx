@@ -0,0 +1,323 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+#ifndef MULTIGRID_CXX
+#define MULTIGRID_CXX
+
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+
+#include "../header/Multigrid.h"
+
+namespace HMT
+{
+
+template<typename T>
+Multigrid<T>::Multigrid(const uint64_t& nodeX, const uint64_t& nodeY, const uint8_t* isFixed):
+	_preSmooth(2), _postSmooth(2), _control(nullptr)
+{
+	Level fine;
+	fine.nodeX = nodeX;
+	fine.nodeY = nodeY;
+	fine.isFixed.assign(isFixed, isFixed + nodeX * nodeY);
+	fine.r.assign(nodeX * nodeY, 0);
+	this->_levels.push_back(std::move(fine));
+
+	// vertex-centred coarsening, coarse node (I, J) sits on fine node (2I, 2J);
+	// for an even node count the last coarse node lies one spacing past the wall
+	while (this->_levels.back().nodeX >= 5 && this->_levels.back().nodeY >= 5) {
+		Level coarse;
+		coarse.nodeX = this->_levels.back().nodeX / 2 + 1;
+		coarse.nodeY = this->_levels.back().nodeY / 2 + 1;
+		this->buildCoarse(this->_levels.back(), coarse);
+		this->_levels.push_back(std::move(coarse));
+	}
+}
+
+template<typename T>
+void Multigrid<T>::setSmoothing(const unsigned int preSmooth, const unsigned int postSmooth) noexcept(true)
+{
+	this->_preSmooth = preSmooth;
+	this->_postSmooth = postSmooth;
+}
+
+template<typename T>
+void Multigrid<T>::setSolveControl(SolveControl* control) noexcept(true)
+{
+	this->_control = control;
+}
+
+template<typename T>
+uint64_t Multigrid<T>::getLevelCount(void) const noexcept(true)
+{
+	return this->_levels.size();
+}
+
+template<typename T>
+uint64_t Multigrid<T>::getBytes(void) const noexcept(true)
+{
+	uint64_t bytes = 0;
+	for (const Level& level : this->_levels) {
+		bytes += level.isFixed.capacity() + (level.stencil.capacity() + level.u.capacity() +
+			level.f.capacity() + level.r.capacity()) * sizeof(T);
+	}
+	return bytes;
+}
+
+template<typename T>
+uint64_t Multigrid<T>::solve(T* grid, const prec_t& epsilon, const bool fullMultigrid)
+{
+	uint64_t cycles = 0;
+	this->_residualHistory.clear();
+	if (fullMultigrid) {
+		this->fullMultigrid(0, grid, nullptr);
+		this->_residualHistory.push_back(this->residual(grid));
+		++cycles;
+	}
+	while (cycles == 0 || epsilon <= this->_residualHistory.back()) {
+		if (this->_control && cycles > 0 && this->_control->poll(cycles, this->_residualHistory.back()))
+			break;
+		this->vCycle(0, grid, nullptr);
+		this->_residualHistory.push_back(this->residual(grid));
+		++cycles;
+	}
+	return cycles;
+}
+
+template<typename T>
+const std::vector<prec_t>& Multigrid<T>::getResidualHistory(void) const noexcept(true)
+{
+	return this->_residualHistory;
+}
+
+template<typename T>
+prec_t Multigrid<T>::residual(const T* grid) const
+{
+	const Level& level = this->_levels.front();
+	prec_t diff = 0.0f;
+	for (uint64_t i = 1; i < level.nodeY - 1; ++i) {
+		const T* row = grid + i * level.nodeX;
+		const uint8_t* isFixed = &level.isFixed[i * level.nodeX];
+		for (uint64_t j = 1; j < level.nodeX - 1; ++j) {
+			if (isFixed[j])
+				continue;
+			const T temp = (row[j - level.nodeX] + row[j + level.nodeX] + row[j - 1] + row[j + 1]) / 4;
+			diff = std::max<prec_t>(diff, std::fabs(temp - row[j]));
+		}
+	}
+	return diff;
+}
+
+template<typename T>
+void Multigrid<T>::buildCoarse(const Level& fine, Level& coarse)
+{
+	const uint64_t size = coarse.nodeX * coarse.nodeY;
+	coarse.isFixed.assign(size, 0);
+	coarse.stencil.assign(9 * size, 0);
+	coarse.u.assign(size, 0);
+	coarse.f.assign(size, 0);
+	coarse.r.assign(size, 0);
+
+	// probe R A P with one unit vector per 3x3 colour class; the images of
+	// same-coloured coarse nodes never overlap, so each probe yields one
+	// stencil entry for every coarse row
+	std::vector<T> e(size), p(fine.nodeX * fine.nodeY), ap(fine.nodeX * fine.nodeY), g(size);
+	for (uint64_t ci = 0; ci < 3; ++ci) {
+		for (uint64_t cj = 0; cj < 3; ++cj) {
+			std::fill(e.begin(), e.end(), static_cast<T>(0));
+			for (uint64_t i = 1; i < coarse.nodeY - 1; ++i)
+				for (uint64_t j = 1; j < coarse.nodeX - 1; ++j)
+					if (i % 3 == ci && j % 3 == cj)
+						e[i * coarse.nodeX + j] = 1;
+			std::fill(p.begin(), p.end(), static_cast<T>(0));
+			this->prolongate(coarse, e.data(), fine, p.data());
+			this->applyOperator(fine, p.data(), ap.data());
+			this->restrictResidual(fine, ap.data(), coarse, g.data());
+
+			for (uint64_t i = 1; i < coarse.nodeY - 1; ++i) {
+				const uint64_t di = (ci + 3 - i % 3) % 3 == 2 ? 0 : (ci + 3 - i % 3) % 3 + 1;
+				for (uint64_t j = 1; j < coarse.nodeX - 1; ++j) {
+					const uint64_t dj = (cj + 3 - j % 3) % 3 == 2 ? 0 : (cj + 3 - j % 3) % 3 + 1;
+					coarse.stencil[9 * (i * coarse.nodeX + j) + 3 * di + dj] = g[i * coarse.nodeX + j];
+				}
+			}
+		}
+	}
+
+	// a coarse node whose whole interpolation support is fixed carries no unknown
+	for (uint64_t k = 0; k < size; ++k)
+		if (!(coarse.stencil[9 * k + 4] > 0))
+			coarse.isFixed[k] = 1;
+}
+
+template<typename T>
+void Multigrid<T>::applyOperator(const Level& level, const T* u, T* out) const
+{
+	const uint64_t nx = level.nodeX;
+	std::fill(out, out + nx * level.nodeY, static_cast<T>(0));
+	for (uint64_t i = 1; i < level.nodeY - 1; ++i) {
+		for (uint64_t j = 1; j < nx - 1; ++j) {
+			const uint64_t k = i * nx + j;
+			if (level.isFixed[k])
+				continue;
+			if (level.stencil.empty()) {
+				out[k] = 4 * u[k] - u[k - nx] - u[k + nx] - u[k - 1] - u[k + 1];
+			} else {
+				const T* a = &level.stencil[9 * k];
+				out[k] = a[0] * u[k - nx - 1] + a[1] * u[k - nx] + a[2] * u[k - nx + 1] +
+						 a[3] * u[k - 1] + a[4] * u[k] + a[5] * u[k + 1] +
+						 a[6] * u[k + nx - 1] + a[7] * u[k + nx] + a[8] * u[k + nx + 1];
+			}
+		}
+	}
+}
+
+template<typename T>
+void Multigrid<T>::vCycle(const uint64_t& level, T* u, const T* f)
+{
+	Level& fine = this->_levels[level];
+	if (level + 1 == this->_levels.size()) {
+		// coarsest level: the short axis has only a few interior nodes, so
+		// Gauss-Seidel converges in a number of sweeps proportional to its size
+		this->smooth(fine, u, f, static_cast<unsigned int>(2 * (fine.nodeX + fine.nodeY)));
+		return;
+	}
+	Level& coarse = this->_levels[level + 1];
+
+	this->smooth(fine, u, f, this->_preSmooth);
+	this->computeResidual(fine, u, f, fine.r.data());
+	this->restrictResidual(fine, fine.r.data(), coarse, coarse.f.data());
+	std::fill(coarse.u.begin(), coarse.u.end(), static_cast<T>(0));
+	this->vCycle(level + 1, coarse.u.data(), coarse.f.data());
+	this->prolongate(coarse, coarse.u.data(), fine, u);
+	this->smooth(fine, u, f, this->_postSmooth);
+}
+
+template<typename T>
+void Multigrid<T>::fullMultigrid(const uint64_t& level, T* u, const T* f)
+{
+	Level& fine = this->_levels[level];
+	if (level + 1 == this->_levels.size()) {
+		this->vCycle(level, u, f);
+		return;
+	}
+	Level& coarse = this->_levels[level + 1];
+
+	// solve for the correction of the initial defect one level down first and
+	// use it as the starting guess, then finish the level with a V-cycle
+	this->computeResidual(fine, u, f, fine.r.data());
+	this->restrictResidual(fine, fine.r.data(), coarse, coarse.f.data());
+	std::vector<T> correction(coarse.nodeX * coarse.nodeY, 0);
+	this->fullMultigrid(level + 1, correction.data(), coarse.f.data());
+	this->prolongate(coarse, correction.data(), fine, u);
+	this->vCycle(level, u, f);
+}
+
+template<typename T>
+void Multigrid<T>::smooth(const Level& level, T* u, const T* f, const unsigned int sweeps) const
+{
+	const uint64_t nx = level.nodeX;
+	for (unsigned int s = 0; s < sweeps; ++s) {
+		if (level.stencil.empty()) {
+			// red-black Gauss-Seidel on 4u - N - S - E - W = f
+			for (unsigned int color = 0; color < 2; ++color) {
+				for (uint64_t i = 1; i < level.nodeY - 1; ++i) {
+					T* row = u + i * nx;
+					const uint8_t* isFixed = &level.isFixed[i * nx];
+					for (uint64_t j = 2 - ((i + color) & 1); j < nx - 1; j += 2) {
+						if (isFixed[j])
+							continue;
+						const T sum = row[j - nx] + row[j + nx] + row[j - 1] + row[j + 1];
+						row[j] = f ? (sum + f[i * nx + j]) / 4 : sum / 4;
+					}
+				}
+			}
+		} else {
+			// lexicographic Gauss-Seidel, the 9-point stencil couples both colours
+			for (uint64_t i = 1; i < level.nodeY - 1; ++i) {
+				for (uint64_t j = 1; j < nx - 1; ++j) {
+					const uint64_t k = i * nx + j;
+					if (level.isFixed[k])
+						continue;
+					const T* a = &level.stencil[9 * k];
+					const T offDiag = a[0] * u[k - nx - 1] + a[1] * u[k - nx] + a[2] * u[k - nx + 1] +
+									  a[3] * u[k - 1] + a[5] * u[k + 1] +
+									  a[6] * u[k + nx - 1] + a[7] * u[k + nx] + a[8] * u[k + nx + 1];
+					u[k] = ((f ? f[k] : static_cast<T>(0)) - offDiag) / a[4];
+				}
+			}
+		}
+	}
+}
+
+template<typename T>
+void Multigrid<T>::computeResidual(const Level& level, const T* u, const T* f, T* r) const
+{
+	this->applyOperator(level, u, r);
+	const uint64_t size = level.nodeX * level.nodeY;
+	for (uint64_t k = 0; k < size; ++k)
+		r[k] = level.isFixed[k] ? static_cast<T>(0) : (f ? f[k] : static_cast<T>(0)) - r[k];
+}
+
+template<typename T>
+void Multigrid<T>::restrictResidual(const Level& fine, const T* r, const Level& coarse, T* f) const
+{
+	// transpose of prolongate(), so R A P stays symmetric; r is zero on fixed fine nodes
+	const uint64_t nx = fine.nodeX;
+	std::fill(f, f + coarse.nodeX * coarse.nodeY, static_cast<T>(0));
+	for (uint64_t i = 1; i < coarse.nodeY - 1; ++i) {
+		for (uint64_t j = 1; j < coarse.nodeX - 1; ++j) {
+			if (coarse.isFixed[i * coarse.nodeX + j])
+				continue;
+			const uint64_t k = 2 * i * nx + 2 * j;
+			const T sum = 4 * r[k] +
+				2 * (r[k - 1] + r[k + 1] + r[k - nx] + r[k + nx]) +
+				(r[k - nx - 1] + r[k - nx + 1] + r[k + nx - 1] + r[k + nx + 1]);
+			f[i * coarse.nodeX + j] = sum / 4;
+		}
+	}
+}
+
+template<typename T>
+void Multigrid<T>::prolongate(const Level& coarse, const T* e, const Level& fine, T* u) const
+{
+	// bilinear, added only where the fine node is free
+	const uint64_t nx = coarse.nodeX;
+	for (uint64_t i = 1; i < fine.nodeY - 1; ++i) {
+		const uint64_t ci = i / 2, oi = i & 1;
+		for (uint64_t j = 1; j < fine.nodeX - 1; ++j) {
+			if (fine.isFixed[i * fine.nodeX + j])
+				continue;
+			const uint64_t cj = j / 2, oj = j & 1;
+			u[i * fine.nodeX + j] += (e[ci * nx + cj] + e[ci * nx + cj + oj] +
+				e[(ci + oi) * nx + cj] + e[(ci + oi) * nx + cj + oj]) / 4;
+		}
+	}
+}
+
+}
+
+#endif
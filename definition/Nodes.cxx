@@ -32,7 +32,13 @@ SOFTWARE.
 #include <cstdint>
 #include <chrono>
 #include <thread>
-#include <mutex>
+#include <algorithm>
+#include <memory>
+#include <limits>
+#include <future>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
 
 #include "../header/Nodes.h"
 
@@ -41,8 +47,6 @@ using std::clog;
 using std::cin;
 using std::make_pair;
 
-using prec_t = long double;
-
 namespace HMT
 {
 
@@ -68,18 +72,148 @@ uint64_t Nodes<T>::getItterCount(void) const
 	}
 }
 
+template<typename T>
+const std::vector<prec_t>& Nodes<T>::getResidualHistory(void) const noexcept(true)
+{
+	return this->_residualHistory;
+}
+
+template<typename T>
+MemoryFootprint Nodes<T>::getMemoryFootprint(void) const noexcept(true)
+{
+	return MemoryFootprint{(this->_nodes.capacity() + this->_nodesOld.capacity()) * sizeof(T),
+		this->_isHeatSource.capacity(), this->_scratchBytes, this->_peakBytes};
+}
+
+template<typename T>
+uint64_t Nodes<T>::heldBytes(void) const noexcept(true)
+{
+	return (this->_nodes.capacity() + this->_nodesOld.capacity()) * sizeof(T) + this->_isHeatSource.capacity();
+}
+
+template<typename T>
+void Nodes<T>::noteScratch(const uint64_t& bytes) noexcept(true)
+{
+	this->_scratchBytes = std::max(this->_scratchBytes, bytes);
+	this->_peakBytes = std::max(this->_peakBytes, this->heldBytes() + bytes);
+}
+
+template<typename T>
+void Nodes<T>::setConvergencePolicy(const ConvergencePolicy& policy) noexcept(true)
+{
+	this->_hasCalculated = false;
+	this->_convergence = policy;
+}
+
+template<typename T>
+ConvergencePolicy Nodes<T>::getConvergencePolicy(void) const noexcept(true)
+{
+	return this->_convergence;
+}
+
+template<typename T>
+bool Nodes<T>::hasConverged(void) const noexcept(true)
+{
+	return this->_hasConverged;
+}
+
+template<typename T>
+bool Nodes<T>::saveCheckpoint(const std::string& path) const
+{
+	if (this->_store) {
+		clog << "Nodes: a store-backed plate has no checkpoint, its store is one" << endl;
+		return false;
+	}
+	const prec_t residual = this->_residualHistory.empty() ? 0.0f : this->_residualHistory.back();
+	return this->writeCheckpoint(path, this->_nodes.data(), this->_itterCnt, residual);
+}
+
+template<typename T>
+bool Nodes<T>::writeResult(const std::string& path, const ResultFormat format, const unsigned int precision) const
+{
+	if (!this->_store)
+		return ResultWriter::write(path, format, this->_nodeX, this->_nodeY, this->_nodes.data(), precision);
+	std::vector<T> chunk;
+	uint64_t chunkBegin = 0;
+	return ResultWriter::writeRows<T>(path, format, this->_nodeX, this->_nodeY,
+		[&] (const uint64_t& row) -> const T* { return this->rowAt(row, chunk, chunkBegin); }, precision);
+}
+
+template<typename T>
+bool Nodes<T>::loadCheckpoint(const std::string& path)
+{
+	if (this->_store) {
+		clog << "Nodes: a store-backed plate cannot load a checkpoint into memory" << endl;
+		return false;
+	}
+	const CheckpointFile file(path);
+	if (!file.holds<T>())
+		return false;
+	const CheckpointHeader& header = file.header();
+	const uint64_t size = header.nodeX * header.nodeY;
+	this->_nodeX = header.nodeX;
+	this->_nodeY = header.nodeY;
+	// straight out of the mapping, nothing to parse or rebuild through setWallTemp
+	this->_nodes.assign(file.values<T>(), file.values<T>() + size);
+	// the second generation is sized by the next solve, page faults are most of a load
+	this->_nodesOld.clear();
+	this->_isHeatSource.assign(file.mask(), file.mask() + size);
+	this->_placedThreads = 0;
+	this->_hasHeatSource = std::any_of(this->_isHeatSource.begin(), this->_isHeatSource.end(),
+		[] (const uint8_t isHeatSource) -> bool { return isHeatSource != 0; });
+	// the same nodes setWallTemp compares against, corners belong to north and south
+	this->_wallTemp[0] = this->_nodes[this->index(1, 0)];
+	this->_wallTemp[1] = this->_nodes[this->index(this->_nodeX - 1, 1)];
+	this->_wallTemp[2] = this->_nodes[this->index(1, this->_nodeY - 1)];
+	this->_wallTemp[3] = this->_nodes[this->index(0, 1)];
+	this->_itterCnt = header.itterCnt;
+	this->_restartItterCnt = header.itterCnt;
+	// a snapshot is as good a starting guess as a finished solve
+	this->_hasSolution = true;
+	this->_edited.clear();
+	this->_residualHistory.assign(1, static_cast<prec_t>(header.residual));
+	this->_tileScratch.clear();
+	this->_hasCalculated = false;
+	return true;
+}
+
+template<typename T>
+void Nodes<T>::setCheckpointing(const std::string& path, const uint64_t& everySweeps)
+{
+	this->_checkpointPath = path;
+	this->_checkpointEvery = everySweeps;
+}
+
+template<typename T>
+bool Nodes<T>::isCheckpointSweep(const uint64_t& itterCnt) const noexcept(true)
+{
+	return this->_checkpointEvery > 0 && itterCnt % this->_checkpointEvery == 0;
+}
+
+template<typename T>
+bool Nodes<T>::writeCheckpoint(const std::string& path, const T* grid, const uint64_t& itterCnt,
+		const prec_t& residual) const
+{
+	return CheckpointFile::write(path, this->_nodeX, this->_nodeY, itterCnt, residual,
+		grid, this->_isHeatSource.data());
+}
+
 template<typename T>
 void Nodes<T>::testBuffers(void) const
 {
+	std::vector<T> chunk;
+	uint64_t chunkBegin = 0;
 	for (uint64_t i = 0; i < this->_nodeY; ++i) {
-		for (uint64_t j = 0; j < this->_nodeX; ++j) {
-			cout << this->_nodes[i][j].first << ", ";
+		const T* row = this->rowAt(i, chunk, chunkBegin);
+		for (uint64_t j = 0; row && j < this->_nodeX; ++j) {
+			cout << row[j] << ", ";
 		}
 		cout << endl;
 	}
-	for (uint64_t i = 0; i < this->_nodeY; ++i) {
+	// a freshly loaded checkpoint has no second generation until it is solved
+	for (uint64_t i = 0; i < this->_nodeY && !this->_nodesOld.empty(); ++i) {
 		for (uint64_t j = 0; j < this->_nodeX; ++j) {
-			cout << this->_nodesOld[i][j].first << ", ";
+			cout << this->_nodesOld[this->index(j, i)] << ", ";
 		}
 		cout << endl;
 	}
@@ -91,48 +225,215 @@ Nodes<T>::Nodes(const uint64_t& nodeX, const uint64_t& nodeY)
 	this->_nodeX = nodeX;
 	this->_nodeY = nodeY;
 	this->initBuffer();
+	this->initState();
+}
+
+template<typename T>
+Nodes<T>::Nodes(const uint64_t& nodeX, const uint64_t& nodeY, const std::string& storePath)
+{
+	this->_nodeX = nodeX;
+	this->_nodeY = nodeY;
+	this->_placedThreads = 0;
+	this->initState();
+	// a freshly sized file reads as zeros, as initBuffer leaves a plate in memory
+	const uint64_t genBytes = (nodeX * nodeY * sizeof(T) + 4095) & ~static_cast<uint64_t>(4095);
+	this->_store = std::make_shared<TileStore>(storePath);
+	this->_storeGen = 0;
+	this->_storeMask = 2 * genBytes;
+	if (!this->_store->reserve(this->_storeMask + nodeX * nodeY))
+		clog << "Nodes: no store for a store-backed plate, it cannot be edited or solved" << endl;
+}
+
+template<typename T>
+void Nodes<T>::initState(void)
+{
 	this->_hasHeatSource = false;
 	this->_hasCalculated = false;
 	this->_canUseThreads = false;
+	this->_threadCnt = 0;
+	this->_processCnt = 0;
+	std::fill(this->_wallTemp, this->_wallTemp + 4, static_cast<T>(0));
+	this->_solverMode = SolverMode::Jacobi;
+	this->_preconditioner = Preconditioner::SSOR;
+	this->_tiling = TileShape{0, 0, 0};
+	this->_convergence = ConvergencePolicy();
+	this->_hasConverged = false;
+	this->_checkpointEvery = 0;
+	this->_warmStart = false;
+	this->_hasSolution = false;
+	this->_smoothRadius = 0;
+	this->_smoothSweeps = 0;
+	this->_restartItterCnt = 0;
+	this->_lowPrecision = LowPrecision::Float;
+	this->_lowSweeps = 0;
+	this->_highSweeps = 0;
+	this->_omega = 0;
+	this->_scratchBytes = 0;
+	this->_peakBytes = 0;
+	this->_streamBandRows = 0;
+	this->_streamCap = 0;
+	this->_streamSteps = 4;
+	this->_streamStats = StreamStats{0, 0, std::chrono::nanoseconds(0), std::chrono::nanoseconds(0),
+		std::chrono::nanoseconds(0), 0, std::chrono::nanoseconds(0)};
+	this->_storeGen = 0;
+	this->_storeMask = 0;
 }
 
 template<typename T>
 void Nodes<T>::initBuffer(void)
 {
-	this->_nodes.reserve(this->_nodeY);
-	this->_nodesOld.reserve(this->_nodeY);
-	for (uint64_t i = 0; i < this->_nodeY; ++i) {
-		std::vector<std::pair<T, bool>> tmp;
-		tmp.reserve(this->_nodeX);
-		for (uint64_t j = 0; j < this->_nodeX; ++j) {
-			tmp.push_back(make_pair(static_cast<T>(0), false));
+	this->_nodes.assign(this->_nodeX * this->_nodeY, static_cast<T>(0));
+	// the first solve that sweeps between two generations sizes the second one
+	AlignedVector<T>().swap(this->_nodesOld);
+	this->_isHeatSource.assign(this->_nodeX * this->_nodeY, 0);
+	this->_placedThreads = 0;
+}
+
+template<typename T>
+inline uint64_t Nodes<T>::index(const uint64_t& posX, const uint64_t& posY) const noexcept(true)
+{
+	return posY * this->_nodeX + posX;
+}
+
+template<typename T>
+T Nodes<T>::nodeAt(const uint64_t& k) const
+{
+	if (!this->_store)
+		return this->_nodes[k];
+	T value = 0;
+	this->_store->read(this->_storeGen + k * sizeof(T), &value, sizeof(T));
+	return value;
+}
+
+template<typename T>
+bool Nodes<T>::isFixedAt(const uint64_t& k) const
+{
+	if (!this->_store)
+		return this->_isHeatSource[k] != 0;
+	uint8_t isFixed = 0;
+	this->_store->read(this->_storeMask + k, &isFixed, 1);
+	return isFixed != 0;
+}
+
+template<typename T>
+void Nodes<T>::setNodeAt(const uint64_t& k, const T& value, const uint8_t isFixed)
+{
+	if (!this->_store) {
+		this->_nodes[k] = value;
+		this->_isHeatSource[k] = isFixed;
+		return;
+	}
+	// the other generation's walls are what a pass leaves in place
+	const uint64_t otherGen = this->_storeMask / 2 - this->_storeGen;
+	this->_store->write(this->_storeGen + k * sizeof(T), &value, sizeof(T));
+	this->_store->write(otherGen + k * sizeof(T), &value, sizeof(T));
+	this->_store->write(this->_storeMask + k, &isFixed, 1);
+}
+
+template<typename T>
+bool Nodes<T>::anyFixed(void) const
+{
+	if (!this->_store)
+		return std::any_of(this->_isHeatSource.begin(), this->_isHeatSource.end(),
+			[] (const uint8_t isHeatSource) -> bool { return isHeatSource != 0; });
+	const uint64_t cells = this->_nodeX * this->_nodeY;
+	std::vector<uint8_t> chunk(std::min<uint64_t>(cells, 1 << 20));
+	for (uint64_t at = 0; at < cells; at += chunk.size()) {
+		const uint64_t n = std::min<uint64_t>(chunk.size(), cells - at);
+		if (!this->_store->read(this->_storeMask + at, chunk.data(), n))
+			return false;
+		if (std::any_of(chunk.begin(), chunk.begin() + n, [] (const uint8_t isFixed) -> bool { return isFixed != 0; }))
+			return true;
+	}
+	return false;
+}
+
+template<typename T>
+const T* Nodes<T>::rowAt(const uint64_t& row, std::vector<T>& chunk, uint64_t& chunkBegin) const
+{
+	const uint64_t nx = this->_nodeX;
+	if (!this->_store)
+		return this->_nodes.data() + row * nx;
+	if (chunk.empty() || row < chunkBegin || row >= chunkBegin + chunk.size() / nx) {
+		const uint64_t rows = std::min(std::max<uint64_t>(1, (1 << 20) / (nx * sizeof(T))), this->_nodeY - row);
+		chunk.resize(rows * nx);
+		chunkBegin = row;
+		if (!this->_store->read(this->_storeGen + row * nx * sizeof(T), chunk.data(), rows * nx * sizeof(T))) {
+			chunk.clear();
+			return nullptr;
 		}
-		this->_nodes.push_back(tmp);
-		this->_nodesOld.push_back(std::move(tmp));
 	}
-	for (uint64_t i = 0; i < this->_nodeY; i++) {
-		this->_nodes[i].shrink_to_fit();
-		this->_nodesOld[i].shrink_to_fit();
+	return chunk.data() + (row - chunkBegin) * nx;
+}
+
+template<typename T>
+void Nodes<T>::editStoreRows(const std::function<void(const uint64_t&, T*, const uint8_t*)>& edit)
+{
+	const uint64_t nx = this->_nodeX, rowBytes = nx * sizeof(T);
+	const uint64_t otherGen = this->_storeMask / 2 - this->_storeGen;
+	std::vector<T> row(nx);
+	std::vector<uint8_t> mask(nx);
+	for (uint64_t i = 0; i < this->_nodeY; ++i) {
+		if (!this->_store->read(this->_storeGen + i * rowBytes, row.data(), rowBytes) ||
+				!this->_store->read(this->_storeMask + i * nx, mask.data(), nx))
+			return;
+		edit(i, row.data(), mask.data());
+		if (!this->_store->write(this->_storeGen + i * rowBytes, row.data(), rowBytes) ||
+				!this->_store->write(otherGen + i * rowBytes, row.data(), rowBytes))
+			return;
 	}
-	this->_nodes.shrink_to_fit();
-	this->_nodesOld.shrink_to_fit();
 }
 
 template<typename T>
 void Nodes<T>::setWallTemp(const T& northTemp, const T& eastTemp, const T& southTemp, const T& westTemp)
 {
 	this->_hasCalculated = false;
+	this->_restartItterCnt = 0;
+	// only walls that actually change mark their strip as edited
+	if (this->nodeAt(this->index(0, 1)) != westTemp)
+		this->markEdited(0, 0, 1, this->_nodeY);
+	if (this->nodeAt(this->index(this->_nodeX - 1, 1)) != eastTemp)
+		this->markEdited(this->_nodeX - 1, 0, this->_nodeX, this->_nodeY);
+	if (this->nodeAt(this->index(1, 0)) != northTemp)
+		this->markEdited(0, 0, this->_nodeX, 1);
+	if (this->nodeAt(this->index(1, this->_nodeY - 1)) != southTemp)
+		this->markEdited(0, this->_nodeY - 1, this->_nodeX, this->_nodeY);
+	this->_wallTemp[0] = northTemp;
+	this->_wallTemp[1] = eastTemp;
+	this->_wallTemp[2] = southTemp;
+	this->_wallTemp[3] = westTemp;
+	if (this->_store) {
+		// the same values as below, one row at a time
+		const bool isReset = !(this->_warmStart && this->_hasSolution);
+		const uint64_t nx = this->_nodeX, ny = this->_nodeY;
+		this->editStoreRows([&] (const uint64_t& i, T* row, const uint8_t* mask) -> void {
+			if (i == 0 || i == ny - 1) {
+				std::fill(row, row + nx, i == 0 ? northTemp : southTemp);
+				return;
+			}
+			row[0] = westTemp;
+			row[nx - 1] = eastTemp;
+			for (uint64_t j = 1; isReset && j < nx - 1; ++j)
+				if (!mask[j])
+					row[j] = (northTemp + eastTemp + southTemp + westTemp) / 4;
+		});
+		return;
+	}
 	for (uint64_t i = 0; i < this->_nodeY; ++i) {
-		this->_nodes[i][0].first = westTemp;
-		this->_nodes[i][this->_nodeX - 1].first = eastTemp;
+		this->_nodes[this->index(0, i)] = westTemp;
+		this->_nodes[this->index(this->_nodeX - 1, i)] = eastTemp;
 	}
 	for (uint64_t i = 0; i < this->_nodeX; ++i) {
-		this->_nodes[0][i].first = northTemp;
-		this->_nodes[this->_nodeY - 1][i].first = southTemp;
+		this->_nodes[this->index(i, 0)] = northTemp;
+		this->_nodes[this->index(i, this->_nodeY - 1)] = southTemp;
 	}
+	if (this->_warmStart && this->_hasSolution)
+		return;
 	for (uint64_t i = 1; i < this->_nodeY - 1; ++i) {
 		for (uint64_t j = 1; j < this->_nodeX - 1; ++j) {
-			this->_nodes[i][j].first = (northTemp + eastTemp + southTemp + westTemp) / 4;
+			if (this->_isHeatSource[this->index(j, i)])
+				continue;
+			this->_nodes[this->index(j, i)] = (northTemp + eastTemp + southTemp + westTemp) / 4;
 		}
 	}
 }
@@ -142,8 +443,108 @@ void Nodes<T>::setHeatSource(const uint64_t& posX, const uint64_t& posY, const T
 {
 	this->_hasHeatSource = true;
 	this->_hasCalculated = false;
-	this->_nodes[posY][posX].first = temp;
-	this->_nodes[posY][posX].second = true;
+	this->_restartItterCnt = 0;
+	this->setNodeAt(this->index(posX, posY), temp, 1);
+	this->markEdited(posX, posY, posX + 1, posY + 1);
+}
+
+template<typename T>
+void Nodes<T>::removeHeatSource(const uint64_t& posX, const uint64_t& posY)
+{
+	const uint64_t k = this->index(posX, posY);
+	if (!this->isFixedAt(k))
+		return;
+	this->_hasCalculated = false;
+	this->_restartItterCnt = 0;
+	// a wall node has no four neighbours; corners are north and south, as setWallTemp writes them
+	T temp;
+	if (posY == 0)
+		temp = this->_wallTemp[0];
+	else if (posY == this->_nodeY - 1)
+		temp = this->_wallTemp[2];
+	else if (posX == 0)
+		temp = this->_wallTemp[3];
+	else if (posX == this->_nodeX - 1)
+		temp = this->_wallTemp[1];
+	else
+		temp = (this->nodeAt(k - this->_nodeX) + this->nodeAt(k + this->_nodeX) +
+			this->nodeAt(k - 1) + this->nodeAt(k + 1)) / 4;
+	this->setNodeAt(k, temp, 0);
+	this->_hasHeatSource = this->anyFixed();
+	this->markEdited(posX, posY, posX + 1, posY + 1);
+}
+
+template<typename T>
+void Nodes<T>::setInitialGuess(const T* grid)
+{
+	this->_hasCalculated = false;
+	this->_restartItterCnt = 0;
+	if (this->_store) {
+		const uint64_t nx = this->_nodeX, ny = this->_nodeY;
+		this->editStoreRows([&] (const uint64_t& i, T* row, const uint8_t* mask) -> void {
+			for (uint64_t j = 1; i > 0 && i < ny - 1 && j < nx - 1; ++j)
+				if (!mask[j])
+					row[j] = grid[i * nx + j];
+		});
+		this->_hasSolution = true;
+		return;
+	}
+	for (uint64_t i = 1; i < this->_nodeY - 1; ++i) {
+		for (uint64_t j = 1; j < this->_nodeX - 1; ++j) {
+			const uint64_t k = this->index(j, i);
+			if (!this->_isHeatSource[k])
+				this->_nodes[k] = grid[k];
+		}
+	}
+	this->_hasSolution = true;
+}
+
+template<typename T>
+void Nodes<T>::setWarmStart(const bool choice) noexcept(true)
+{
+	this->_warmStart = choice;
+}
+
+template<typename T>
+bool Nodes<T>::getWarmStart(void) const noexcept(true)
+{
+	return this->_warmStart;
+}
+
+template<typename T>
+void Nodes<T>::setPreSmoothing(const uint64_t& radius, const unsigned int sweeps) noexcept(true)
+{
+	this->_smoothRadius = radius;
+	this->_smoothSweeps = sweeps;
+}
+
+template<typename T>
+void Nodes<T>::markEdited(const uint64_t& x0, const uint64_t& y0, const uint64_t& x1, const uint64_t& y1)
+{
+	this->_edited.push_back(Region{x0, y0, x1, y1});
+}
+
+template<typename T>
+void Nodes<T>::preSmooth(void)
+{
+	for (const Region& region : this->_edited) {
+		// the window around the edit, clipped to the interior
+		const uint64_t x0 = std::max<uint64_t>(1, region.x0 > this->_smoothRadius ? region.x0 - this->_smoothRadius : 0);
+		const uint64_t y0 = std::max<uint64_t>(1, region.y0 > this->_smoothRadius ? region.y0 - this->_smoothRadius : 0);
+		const uint64_t x1 = std::min(this->_nodeX - 1, region.x1 + this->_smoothRadius);
+		const uint64_t y1 = std::min(this->_nodeY - 1, region.y1 + this->_smoothRadius);
+		for (unsigned int sweep = 0; sweep < this->_smoothSweeps; ++sweep) {
+			for (uint64_t i = y0; i < y1; ++i) {
+				for (uint64_t j = x0; j < x1; ++j) {
+					const uint64_t k = this->index(j, i);
+					if (this->_isHeatSource[k])
+						continue;
+					this->_nodes[k] = (this->_nodes[k - this->_nodeX] + this->_nodes[k + this->_nodeX] +
+						this->_nodes[k - 1] + this->_nodes[k + 1]) / 4;
+				}
+			}
+		}
+	}
 }
 
 template<typename T>
@@ -158,96 +559,1446 @@ bool Nodes<T>::canUseThreads(void) const noexcept(true)
 	return this->_canUseThreads;
 }
 
+template<typename T>
+void Nodes<T>::setSolverMode(const SolverMode mode) noexcept(true)
+{
+	this->_hasCalculated = false;
+	this->_solverMode = mode;
+}
+
+template<typename T>
+SolverMode Nodes<T>::getSolverMode(void) const noexcept(true)
+{
+	return this->_solverMode;
+}
+
+template<typename T>
+void Nodes<T>::setRelaxation(const prec_t omega) noexcept(true)
+{
+	this->_hasCalculated = false;
+	this->_omega = omega;
+}
+
+template<typename T>
+prec_t Nodes<T>::getRelaxation(void) const noexcept(true)
+{
+	if (this->_omega > 0)
+		return this->_omega;
+	// optimal SOR factor from the Jacobi spectral radius of the Dirichlet 5-point Laplacian
+	const prec_t pi = std::acos(static_cast<prec_t>(-1));
+	const prec_t rho = (std::cos(pi / (this->_nodeX > 1 ? this->_nodeX - 1 : 1)) +
+						std::cos(pi / (this->_nodeY > 1 ? this->_nodeY - 1 : 1))) / 2;
+	return 2 / (1 + std::sqrt(1 - rho * rho));
+}
+
+template<typename T>
+void Nodes<T>::setPreconditioner(const Preconditioner preconditioner) noexcept(true)
+{
+	this->_hasCalculated = false;
+	this->_preconditioner = preconditioner;
+}
+
+template<typename T>
+Preconditioner Nodes<T>::getPreconditioner(void) const noexcept(true)
+{
+	return this->_preconditioner;
+}
+
+template<typename T>
+void Nodes<T>::setTiling(const TileShape& shape) noexcept(true)
+{
+	this->_hasCalculated = false;
+	this->_tiling = shape;
+}
+
+template<typename T>
+TileShape Nodes<T>::getTiling(void) const noexcept(true)
+{
+	return this->_tiling;
+}
+
+template<typename T>
+void Nodes<T>::setStreaming(const std::string& path, const uint64_t& bandRows, const unsigned int steps,
+		const uint64_t& memoryCap)
+{
+	this->_hasCalculated = false;
+	this->_streamPath = path;
+	this->_streamBandRows = bandRows;
+	this->_streamCap = memoryCap;
+	this->_streamSteps = std::max(1u, steps);
+}
+
+template<typename T>
+StreamStats Nodes<T>::getStreamStats(void) const noexcept(true)
+{
+	return this->_streamStats;
+}
+
+template<typename T>
+void Nodes<T>::setLowPrecision(const LowPrecision precision) noexcept(true)
+{
+	this->_hasCalculated = false;
+	this->_lowPrecision = precision;
+}
+
+template<typename T>
+LowPrecision Nodes<T>::getLowPrecision(void) const noexcept(true)
+{
+	return this->_lowPrecision;
+}
+
+template<typename T>
+uint64_t Nodes<T>::getLowPrecisionSweeps(void) const noexcept(true)
+{
+	return this->_lowSweeps;
+}
+
+template<typename T>
+uint64_t Nodes<T>::getHighPrecisionSweeps(void) const noexcept(true)
+{
+	return this->_highSweeps;
+}
+
+template<typename T>
+void Nodes<T>::setThreadCount(const unsigned int threadCnt) noexcept(true)
+{
+	this->_threadCnt = threadCnt;
+}
+
+template<typename T>
+unsigned int Nodes<T>::getThreadCount(void) const noexcept(true)
+{
+	unsigned int threadCnt = this->_threadCnt > 0 ? this->_threadCnt : std::thread::hardware_concurrency();
+	// a strip needs at least one interior row
+	if (this->_nodeY < 3)
+		return 1;
+	if (threadCnt > this->_nodeY - 2)
+		threadCnt = static_cast<unsigned int>(this->_nodeY - 2);
+	return threadCnt > 0 ? threadCnt : 1;
+}
+
+template<typename T>
+void Nodes<T>::setProcessCount(const unsigned int processCnt) noexcept(true)
+{
+	this->_processCnt = processCnt;
+}
+
+template<typename T>
+unsigned int Nodes<T>::getProcessCount(void) const noexcept(true)
+{
+	unsigned int processCnt = this->_processCnt > 0 ? this->_processCnt : std::thread::hardware_concurrency();
+	// a band needs at least one interior row
+	if (this->_nodeY < 3)
+		return 1;
+	if (processCnt > this->_nodeY - 2)
+		processCnt = static_cast<unsigned int>(this->_nodeY - 2);
+	return processCnt > 0 ? processCnt : 1;
+}
+
+template<typename T>
+void Nodes<T>::setTelemetry(const std::shared_ptr<Telemetry>& telemetry) noexcept(true)
+{
+	this->_telemetry = telemetry;
+}
+
+template<typename T>
+std::shared_ptr<Telemetry> Nodes<T>::getTelemetry(void) const noexcept(true)
+{
+	return this->_telemetry;
+}
+
+template<typename T>
+void Nodes<T>::setSolveControl(const std::shared_ptr<SolveControl>& control) noexcept(true)
+{
+	this->_control = control;
+}
+
+template<typename T>
+std::shared_ptr<SolveControl> Nodes<T>::getSolveControl(void) const noexcept(true)
+{
+	return this->_control;
+}
+
+template<typename T>
+void Nodes<T>::detachShared(void)
+{
+	this->_threadPool.reset();
+	this->_placedThreads = 0;
+	this->_telemetry.reset();
+	this->_control.reset();
+	this->_checkpointPath.clear();
+	this->_checkpointEvery = 0;
+	if (!this->_store)
+		return;
+	// a temporary file with what the shared one holds now
+	const std::shared_ptr<TileStore> shared = this->_store;
+	const uint64_t bytes = this->_storeMask + this->_nodeX * this->_nodeY;
+	this->_store = std::make_shared<TileStore>("");
+	std::vector<char> chunk(std::min<uint64_t>(bytes, 1 << 20));
+	bool isCopied = this->_store->reserve(bytes);
+	for (uint64_t at = 0; isCopied && at < bytes; at += chunk.size()) {
+		const uint64_t n = std::min<uint64_t>(chunk.size(), bytes - at);
+		isCopied = shared->read(at, chunk.data(), n) && this->_store->write(at, chunk.data(), n);
+	}
+	if (!isCopied)
+		clog << "Nodes: cannot copy the store of a detached plate" << endl;
+}
+
+template<typename T>
+bool Nodes<T>::isStopRequested(const uint64_t& itterCnt, const prec_t& residual) const noexcept(true)
+{
+	return this->_control && this->_control->poll(itterCnt, residual);
+}
+
+template<typename T>
+void Nodes<T>::publishSweep(SweepRecord& record, const uint64_t& itterCnt, const prec_t& residual,
+		const std::chrono::high_resolution_clock::time_point& sweepStart) const
+{
+	record.itterCnt = itterCnt;
+	record.residual = residual;
+	record.sweepTime = std::chrono::high_resolution_clock::now() - sweepStart;
+	const uint64_t cells = (this->_nodeX - 2) * (this->_nodeY - 2);
+	const bool isCounting = this->_telemetry->isCounting();
+	record.cellsUpdated = isCounting ? cells : 0;
+	record.bytesMoved = isCounting ? cells * (2 * sizeof(T) + 1) : 0;
+	this->_telemetry->publish(record);
+}
+
 template<typename T>
 void Nodes<T>::calculate(const prec_t epsilon)
 {
 	if (!this->_hasCalculated) {
 		this->_startTime = std::chrono::high_resolution_clock::now();
-		if (this->_canUseThreads &&
-				(this->_nodeY > this->_nodeX ? this->_nodeY : this->_nodeX) > std::thread::hardware_concurrency() * 4) {
+		const bool isDoubleBuffered = this->_solverMode == SolverMode::Jacobi ||
+			this->_solverMode == SolverMode::TiledJacobi || this->_solverMode == SolverMode::ADI ||
+			this->_solverMode == SolverMode::Distributed;
+		if (!isDoubleBuffered)
+			AlignedVector<T>().swap(this->_nodesOld);
+		else if (this->_nodesOld.size() != this->_nodes.size())
+			this->_nodesOld.resize(this->_nodes.size());
+		this->_scratchBytes = 0;
+		this->_peakBytes = this->heldBytes();
+		if (this->_warmStart && this->_hasSolution && this->_smoothSweeps > 0 && !this->_store)
+			this->preSmooth();
+		// a restarted solve keeps the residual it was saved with until it measures one
+		if (this->_restartItterCnt == 0)
+			this->_residualHistory.clear();
+		// only the Jacobi paths (Distributed, TiledJacobi and OutOfCore included) have a budget to run out of,
+		// any mode can be stopped by its SolveControl
+		this->_hasConverged = true;
+		// a store-backed plate has nothing in memory for the other modes to sweep
+		if (this->_store || this->_solverMode == SolverMode::OutOfCore) {
+			this->calculateOutOfCore(epsilon);
+		} else if (this->_solverMode == SolverMode::RedBlackSOR) {
+			this->calculateSOR(epsilon);
+		} else if (this->_solverMode == SolverMode::Multigrid) {
+			this->calculateMultigrid(epsilon);
+		} else if (this->_solverMode == SolverMode::ConjugateGradient) {
+			this->calculateConjugateGradient(epsilon);
+		} else if (this->_solverMode == SolverMode::TiledJacobi) {
+			this->calculateTiled(epsilon);
+		} else if (this->_solverMode == SolverMode::MixedPrecision) {
+			if (this->_lowPrecision == LowPrecision::Float)
+				this->calculateMixed<float>(epsilon);
+			else
+				this->calculateMixed<double>(epsilon);
+		} else if (this->_solverMode == SolverMode::ADI) {
+			this->calculateADI(epsilon);
+		} else if (this->_solverMode == SolverMode::InPlace) {
+			this->calculateInPlace(epsilon);
+		} else if (this->_solverMode == SolverMode::Distributed) {
+			this->calculateDistributed(epsilon);
+		} else if (this->_canUseThreads && this->getThreadCount() > 1) {
 			this->calculateWThread(epsilon);
 		} else {
-			this->_itterCnt = 0;
-			prec_t diff = epsilon;
-			while (epsilon <= diff) {
-				++(this->_itterCnt);
-				for (uint64_t i = 0; i < this->_nodeY; ++i)
-					for (uint64_t j = 0; j < this->_nodeX; ++j)
-						this->_nodesOld[i][j] = this->_nodes[i][j];
-
-				diff = 0.0f;
-				for (uint64_t i = 1; i < this->_nodeY - 1; ++i) {
-					for (uint64_t j = 1; j < this->_nodeX - 1; ++j) {
-						if (this->_nodes[i][j].second != true) {
-							this->_nodes[i][j].first = (this->_nodesOld[i - 1][j].first +
-														this->_nodesOld[i + 1][j].first +
-												 		this->_nodesOld[i][j - 1].first + 
-												 		this->_nodesOld[i][j + 1].first) / 4;
-							if (diff < std::fabs(this->_nodesOld[i][j].first - this->_nodes[i][j].first)) {
-								diff = std::fabs(this->_nodesOld[i][j].first - this->_nodes[i][j].first);
-							}
-						}
-					}
-				}
-			}
+			this->calculateJacobi(epsilon);
 		}
+		if (this->_control && this->_control->isStopped())
+			this->_hasConverged = false;
+		// a restore only carries into the solve right after it, whatever is set next
+		this->_restartItterCnt = 0;
 		this->_endTime = std::chrono::high_resolution_clock::now();
 		this->_hasCalculated = true;
+		this->_hasSolution = true;
+		this->_edited.clear();
+	}
+}
+
+template<typename T>
+prec_t Nodes<T>::jacobiSweep(const T* src, T* dst, const uint64_t& rowBegin, const uint64_t& rowEnd) const
+{
+	prec_t diff = 0.0f;
+	for (uint64_t i = rowBegin; i < rowEnd; ++i) {
+		diff = std::max(diff, Kernels::jacobiRow(src + this->index(0, i - 1), src + this->index(0, i),
+			src + this->index(0, i + 1), &this->_isHeatSource[this->index(0, i)],
+			dst + this->index(0, i), 1, this->_nodeX - 1));
+	}
+	return diff;
+}
+
+template<typename T>
+prec_t Nodes<T>::policySweep(const T* src, T* dst, const uint64_t& rowBegin, const uint64_t& rowEnd,
+		const bool isCheck, const Norm norm) const
+{
+	if (isCheck && norm == Norm::LInf)
+		return this->jacobiSweep(src, dst, rowBegin, rowEnd);
+	for (uint64_t i = rowBegin; i < rowEnd; ++i) {
+		Kernels::jacobiRowUpdate(src + this->index(0, i - 1), src + this->index(0, i),
+			src + this->index(0, i + 1), &this->_isHeatSource[this->index(0, i)],
+			dst + this->index(0, i), 1, this->_nodeX - 1);
+	}
+	if (!isCheck)
+		return 0.0f;
+	// a second pass over the rows just written; it only runs every checkEvery sweeps
+	prec_t sum = 0.0f;
+	for (uint64_t i = rowBegin; i < rowEnd; ++i) {
+		for (uint64_t j = this->index(1, i); j < this->index(this->_nodeX - 1, i); ++j) {
+			const prec_t change = dst[j] - src[j];
+			sum += change * change;
+		}
+	}
+	return sum;
+}
+
+template<typename T>
+void Nodes<T>::calculateJacobi(const prec_t& epsilon)
+{
+	ConvergenceCheck check(this->_convergence, epsilon);
+	this->_itterCnt = this->_restartItterCnt;
+	prec_t norm = this->_residualHistory.empty() ? 0.0f : this->_residualHistory.back();
+	// the only full copy: walls and heat sources are never written by a
+	// sweep, so after this both generations hold them for good
+	std::copy(this->_nodes.begin(), this->_nodes.end(), this->_nodesOld.begin());
+	const bool isTraced = HMT_TELEMETRY && this->_telemetry;
+	SweepRecord record;
+	record.threadCnt = 1;
+	while (true) {
+		++(this->_itterCnt);
+		const bool isCheck = check.isCheckSweep(this->_itterCnt);
+		const auto sweepStart = isTraced ? std::chrono::high_resolution_clock::now() :
+			std::chrono::high_resolution_clock::time_point();
+		const prec_t measured = this->policySweep(this->_nodes.data(), this->_nodesOld.data(),
+			1, this->_nodeY - 1, isCheck, check.getNorm());
+		this->_nodes.swap(this->_nodesOld);
+		if (isCheck) {
+			norm = check.norm(measured);
+			this->_residualHistory.push_back(norm);
+		}
+		if (isTraced) {
+			record.threadTimes[0] = std::chrono::high_resolution_clock::now() - sweepStart;
+			this->publishSweep(record, this->_itterCnt, isCheck ? norm : -1, sweepStart);
+		}
+		if (this->isCheckpointSweep(this->_itterCnt))
+			this->writeCheckpoint(this->_checkpointPath, this->_nodes.data(), this->_itterCnt, norm);
+		if (this->isStopRequested(this->_itterCnt, norm))
+			break;
+		if (!isCheck)
+			continue;
+		if (check.isConverged(norm))
+			break;
+		if (check.isOutOfBudget(this->_itterCnt)) {
+			this->_hasConverged = false;
+			break;
+		}
 	}
 }
 
 template<typename T>
 void Nodes<T>::calculateWThread(const prec_t& epsilon)
 {
-	unsigned int nofCore = std::thread::hardware_concurrency();
-	std::thread threads[nofCore];
-	auto calc = [&] (uint64_t nodeX, uint64_t nodeY, const prec_t epsilon) -> void {
-		std::mutex myMutex;
-		clog << "thread [id: " << std::this_thread::get_id() << "]" << endl;
+	const unsigned int nofThreads = this->getThreadCount();
+	ThreadPool& threadPool = this->threadPool(nofThreads);
+	this->placeBuffers(threadPool, nofThreads);
+
+	// one slot per thread, padded to a cache line, and two sets of them so a
+	// fast thread can publish sweep k + 1 while others still read sweep k
+	struct alignas(64) Residual { prec_t diff; bool isOutOfBudget, isStopped; std::chrono::nanoseconds busyTime; };
+	std::vector<Residual> residuals(2 * nofThreads);
+	const uint64_t rows = this->_nodeY - 2;
+	const ConvergenceCheck sharedCheck(this->_convergence, epsilon);
+	// what calculateJacobi starts from; read here, worker 0 appends to the history
+	const prec_t restartNorm = this->_residualHistory.empty() ? 0.0f : this->_residualHistory.back();
+	const bool isTraced = HMT_TELEMETRY && this->_telemetry;
+	SweepRecord record;
+	record.threadCnt = nofThreads;
+
+	this->_itterCnt = 0;
+	std::copy(this->_nodes.begin(), this->_nodes.end(), this->_nodesOld.begin());
+	threadPool.run([&] (const unsigned int threadId) -> void {
+		const uint64_t rowBegin = 1 + rows * threadId / nofThreads;
+		const uint64_t rowEnd = 1 + rows * (threadId + 1) / nofThreads;
+		ConvergenceCheck check = sharedCheck;
+		T* src = this->_nodes.data();
+		T* dst = this->_nodesOld.data();
+		uint64_t itterCnt = this->_restartItterCnt;
+		prec_t norm = restartNorm;
+		while (true) {
+			Residual* slots = &residuals[(itterCnt & 1) * nofThreads];
+			++itterCnt;
+			const bool isCheck = check.isCheckSweep(itterCnt);
+			const auto sweepStart = isTraced ? std::chrono::high_resolution_clock::now() :
+				std::chrono::high_resolution_clock::time_point();
+			slots[threadId].diff = this->policySweep(src, dst, rowBegin, rowEnd, isCheck, check.getNorm());
+			if (isTraced)
+				slots[threadId].busyTime = std::chrono::high_resolution_clock::now() - sweepStart;
+			// the clock is read once, by worker 0, so every thread sees the same budget verdict
+			if (isCheck && threadId == 0)
+				slots[0].isOutOfBudget = check.isOutOfBudget(itterCnt);
+			// polled by worker 0 only, with the norm of the last checked sweep
+			if (threadId == 0)
+				slots[0].isStopped = this->isStopRequested(itterCnt, norm);
+			threadPool.barrier().wait();
+			std::swap(src, dst);
+			if (isCheck) {
+				// every thread reduces the same slots, so all reach the same verdict
+				prec_t measured = 0.0f;
+				for (unsigned int i = 0; i < nofThreads; ++i) {
+					if (check.getNorm() == Norm::LInf)
+						measured = std::max(measured, slots[i].diff);
+					else
+						measured += slots[i].diff;
+				}
+				norm = check.norm(measured);
+				if (threadId == 0)
+					this->_residualHistory.push_back(norm);
+			}
+			// the slots of this sweep stay put until worker 0 reaches the next barrier
+			if (isTraced && threadId == 0) {
+				for (unsigned int i = 0; i < nofThreads && i < SweepRecord::maxThreads; ++i)
+					record.threadTimes[i] = slots[i].busyTime;
+				this->publishSweep(record, itterCnt, isCheck ? norm : -1, sweepStart);
+			}
+			// the next sweep only reads src and the one after waits on the barrier
+			if (threadId == 0 && this->isCheckpointSweep(itterCnt))
+				this->writeCheckpoint(this->_checkpointPath, src, itterCnt, norm);
+			if (slots[0].isStopped)
+				break;
+			if (!isCheck)
+				continue;
+			if (check.isConverged(norm))
+				break;
+			if (slots[0].isOutOfBudget) {
+				if (threadId == 0)
+					this->_hasConverged = false;
+				break;
+			}
+		}
+		if (threadId == 0)
+			this->_itterCnt = itterCnt;
+	});
+	// the newest generation sits in _nodesOld after an odd number of sweeps
+	if ((this->_itterCnt - this->_restartItterCnt) & 1)
+		this->_nodes.swap(this->_nodesOld);
+}
+
+template<typename T>
+void Nodes<T>::calculateDistributed(const prec_t& epsilon)
+{
+	const unsigned int nofRanks = this->getProcessCount();
+	const uint64_t rows = this->_nodeY - 2;
+	ShmHaloExchange exchange(nofRanks, this->_nodeX * sizeof(T), this->_nodes.size() * sizeof(T));
+	if (!exchange.isOpen()) {
+		clog << "[Nodes] no shared memory segment for the Distributed mode, solving in this process" << endl;
+		this->calculateJacobi(epsilon);
+		return;
+	}
+	this->noteScratch(exchange.segmentBytes());
+
+	// the children inherit both generations; a band's pages are copied on
+	// their first write, by the rank that owns them
+	std::copy(this->_nodes.begin(), this->_nodes.end(), this->_nodesOld.begin());
+	cout.flush();
+	clog.flush();
+	std::vector<pid_t> ranks;
+	for (unsigned int rank = 0; rank < nofRanks; ++rank) {
+		const pid_t pid = ::fork();
+		if (pid == 0) {
+			exchange.setRank(rank);
+			const bool isDone = this->distributedRank(exchange, epsilon,
+				1 + rows * rank / nofRanks, 1 + rows * (rank + 1) / nofRanks);
+			// no destructors or atexit handlers of the parent's objects in a rank
+			::_exit(isDone ? 0 : 1);
+		}
+		if (pid < 0) {
+			exchange.abort();
+			break;
+		}
+		ranks.push_back(pid);
+	}
+	bool isSolved = ranks.size() == nofRanks;
+	for (const pid_t pid : ranks) {
+		int status = 0;
+		if (::waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+			// the others would otherwise wait on the barrier for the dead one
+			exchange.abort();
+			isSolved = false;
+		}
+	}
+	if (!isSolved) {
+		clog << "[Nodes] a Distributed rank failed, solving in this process" << endl;
+		this->calculateJacobi(epsilon);
+		return;
+	}
+
+	const T* grid = static_cast<const T*>(exchange.grid());
+	for (uint64_t k = this->index(0, 1); k < this->index(0, this->_nodeY - 1); ++k)
+		this->_nodes[k] = grid[k];
+	const RankResult result = exchange.result();
+	this->_itterCnt = result.itterCnt;
+	this->_hasConverged = result.hasConverged;
+	this->_residualHistory.push_back(result.norm);
+}
+
+template<typename T>
+bool Nodes<T>::distributedRank(HaloExchange& exchange, const prec_t& epsilon,
+		const uint64_t& rowBegin, const uint64_t& rowEnd)
+{
+	ConvergenceCheck check(this->_convergence, epsilon);
+	const bool isSum = check.getNorm() != Norm::LInf;
+	T* src = this->_nodes.data();
+	T* dst = this->_nodesOld.data();
+	uint64_t itterCnt = this->_restartItterCnt;
+	prec_t norm = this->_residualHistory.empty() ? 0.0f : this->_residualHistory.back();
+	bool hasConverged = true;
+	while (true) {
+		++itterCnt;
+		const bool isCheck = check.isCheckSweep(itterCnt);
+		prec_t measured = this->policySweep(src, dst, rowBegin, rowEnd, isCheck, check.getNorm());
+		// the clock is read by rank 0 only and its verdict travels with the halos,
+		// so does a stop from the SolveControl
+		bool isOutOfBudget = exchange.rank() == 0 &&
+			((isCheck && check.isOutOfBudget(itterCnt)) || this->isStopRequested(itterCnt, norm));
+		if (!exchange.exchange(dst + this->index(0, rowBegin), dst + this->index(0, rowEnd - 1),
+				dst + this->index(0, rowBegin - 1), dst + this->index(0, rowEnd), measured, isSum, isOutOfBudget))
+			return false;
+		std::swap(src, dst);
+		if (isCheck) {
+			norm = check.norm(measured);
+			if (check.isConverged(norm))
+				break;
+		}
+		if (isOutOfBudget) {
+			hasConverged = false;
+			break;
+		}
+	}
+	return exchange.gather(src + this->index(0, rowBegin), this->index(0, rowBegin) * sizeof(T),
+		(rowEnd - rowBegin) * this->_nodeX * sizeof(T), RankResult{itterCnt, norm, hasConverged});
+}
+
+template<typename T>
+void Nodes<T>::calculateInPlace(const prec_t& epsilon)
+{
+	const unsigned int nofThreads = this->_canUseThreads ? this->getThreadCount() : 1;
+	ThreadPool& threadPool = this->threadPool(nofThreads);
+	const uint64_t nodeX = this->_nodeX;
+
+	// per worker: the rows bordering its band as they were before the sweep,
+	// and two new rows held back until nobody reads the old ones
+	AlignedVector<T> lines(4 * nofThreads * nodeX);
+	this->noteScratch(lines.size() * sizeof(T));
+
+	struct alignas(64) Residual { prec_t diff; bool isOutOfBudget, isStopped; std::chrono::nanoseconds busyTime; };
+	std::vector<Residual> residuals(nofThreads);
+	const uint64_t rows = this->_nodeY - 2;
+	const ConvergenceCheck sharedCheck(this->_convergence, epsilon);
+	// as calculateWThread: read before worker 0 starts appending to the history
+	const prec_t restartNorm = this->_residualHistory.empty() ? 0.0f : this->_residualHistory.back();
+	const bool isTraced = HMT_TELEMETRY && this->_telemetry;
+	SweepRecord record;
+	record.threadCnt = nofThreads;
+
+	this->_itterCnt = 0;
+	threadPool.run([&] (const unsigned int threadId) -> void {
+		const uint64_t rowBegin = 1 + rows * threadId / nofThreads;
+		const uint64_t rowEnd = 1 + rows * (threadId + 1) / nofThreads;
+		ConvergenceCheck check = sharedCheck;
+		T* grid = this->_nodes.data();
+		T* above = &lines[4 * threadId * nodeX];
+		T* below = above + nodeX;
+		T* held[2] = {below + nodeX, below + 2 * nodeX};
+		uint64_t itterCnt = this->_restartItterCnt;
+		prec_t norm = restartNorm;
+		while (true) {
+			++itterCnt;
+			const bool isCheck = check.isCheckSweep(itterCnt);
+			const auto sweepStart = isTraced ? std::chrono::high_resolution_clock::now() :
+				std::chrono::high_resolution_clock::time_point();
+			// the neighbouring bands write these two before this one is done with them
+			std::copy(grid + this->index(0, rowBegin - 1), grid + this->index(0, rowBegin), above);
+			std::copy(grid + this->index(0, rowEnd), grid + this->index(0, rowEnd + 1), below);
+			threadPool.barrier().wait();
+			// the kernels and the order of the sums are policySweep's, so the
+			// grid and the norms come out bitwise as the Jacobi mode's
+			prec_t measured = 0.0f;
+			for (uint64_t i = rowBegin; i < rowEnd; ++i) {
+				const T* north = i == rowBegin ? above : grid + this->index(0, i - 1);
+				const T* south = i + 1 == rowEnd ? below : grid + this->index(0, i + 1);
+				const T* row = grid + this->index(0, i);
+				T* out = held[i & 1];
+				const uint8_t* isFixed = &this->_isHeatSource[this->index(0, i)];
+				if (isCheck && check.getNorm() == Norm::LInf) {
+					measured = std::max(measured, Kernels::jacobiRow(north, row, south, isFixed, out, 1, nodeX - 1));
+				} else {
+					Kernels::jacobiRowUpdate(north, row, south, isFixed, out, 1, nodeX - 1);
+					for (uint64_t j = 1; isCheck && j < nodeX - 1; ++j) {
+						const prec_t change = out[j] - row[j];
+						measured += change * change;
+					}
+				}
+				// the row above has been read for the last time this sweep
+				if (i > rowBegin)
+					std::copy(held[(i - 1) & 1] + 1, held[(i - 1) & 1] + nodeX - 1, grid + this->index(1, i - 1));
+			}
+			std::copy(held[(rowEnd - 1) & 1] + 1, held[(rowEnd - 1) & 1] + nodeX - 1, grid + this->index(1, rowEnd - 1));
+			residuals[threadId].diff = measured;
+			if (isTraced)
+				residuals[threadId].busyTime = std::chrono::high_resolution_clock::now() - sweepStart;
+			if (isCheck && threadId == 0)
+				residuals[0].isOutOfBudget = check.isOutOfBudget(itterCnt);
+			if (threadId == 0)
+				residuals[0].isStopped = this->isStopRequested(itterCnt, norm);
+			threadPool.barrier().wait();
+			// the slots are written again only after the next sweep's first barrier
+			if (isCheck) {
+				measured = 0.0f;
+				for (unsigned int t = 0; t < nofThreads; ++t) {
+					if (check.getNorm() == Norm::LInf)
+						measured = std::max(measured, residuals[t].diff);
+					else
+						measured += residuals[t].diff;
+				}
+				norm = check.norm(measured);
+				if (threadId == 0)
+					this->_residualHistory.push_back(norm);
+			}
+			if (isTraced && threadId == 0) {
+				for (unsigned int t = 0; t < nofThreads && t < SweepRecord::maxThreads; ++t)
+					record.threadTimes[t] = residuals[t].busyTime;
+				this->publishSweep(record, itterCnt, isCheck ? norm : -1, sweepStart);
+			}
+			// the others only read the grid until worker 0 reaches the next barrier
+			if (threadId == 0 && this->isCheckpointSweep(itterCnt))
+				this->writeCheckpoint(this->_checkpointPath, grid, itterCnt, norm);
+			if (residuals[0].isStopped)
+				break;
+			if (!isCheck)
+				continue;
+			if (check.isConverged(norm))
+				break;
+			if (residuals[0].isOutOfBudget) {
+				if (threadId == 0)
+					this->_hasConverged = false;
+				break;
+			}
+		}
+		if (threadId == 0)
+			this->_itterCnt = itterCnt;
+	});
+}
+
+template<typename T>
+prec_t Nodes<T>::sorSweep(T* grid, const unsigned int color, const prec_t& omega,
+		const uint64_t& rowBegin, const uint64_t& rowEnd) const
+{
+	prec_t diff = 0.0f;
+	for (uint64_t i = rowBegin; i < rowEnd; ++i) {
+		const T* north = grid + this->index(0, i - 1);
+		const T* south = grid + this->index(0, i + 1);
+		const uint8_t* isHeatSource = &this->_isHeatSource[this->index(0, i)];
+		T* row = grid + this->index(0, i);
+		// first column of this row whose (i + j) parity matches the colour
+		for (uint64_t j = 2 - ((i + color) & 1); j < this->_nodeX - 1; j += 2) {
+			if (isHeatSource[j])
+				continue;
+			const T delta = static_cast<T>(omega * ((north[j] + south[j] + row[j - 1] + row[j + 1]) / 4 - row[j]));
+			row[j] += delta;
+			diff = std::max<prec_t>(diff, std::fabs(delta));
+		}
+	}
+	return diff;
+}
+
+template<typename T>
+void Nodes<T>::calculateSOR(const prec_t& epsilon)
+{
+	const unsigned int nofThreads = this->_canUseThreads ? this->getThreadCount() : 1;
+	ThreadPool& threadPool = this->threadPool(nofThreads);
+	this->placeBuffers(threadPool, nofThreads);
+	const prec_t omega = this->getRelaxation();
+
+	struct alignas(64) Residual { prec_t diff; bool isStopped; std::chrono::nanoseconds busyTime; };
+	std::vector<Residual> residuals(2 * nofThreads);
+	const uint64_t rows = this->_nodeY - 2;
+	const bool isTraced = HMT_TELEMETRY && this->_telemetry;
+	SweepRecord record;
+	record.threadCnt = nofThreads;
+
+	this->_itterCnt = 0;
+	threadPool.run([&] (const unsigned int threadId) -> void {
+		const uint64_t rowBegin = 1 + rows * threadId / nofThreads;
+		const uint64_t rowEnd = 1 + rows * (threadId + 1) / nofThreads;
+		uint64_t itterCnt = this->_restartItterCnt;
 		prec_t diff = epsilon;
 		while (epsilon <= diff) {
-			++(this->_itterCnt);
-			for (uint64_t i = 0; i < nodeY; ++i)
-				for (uint64_t j = 0; j < nodeX; ++j) {
-					std::lock_guard<std::mutex> guard(myMutex);
-					this->_nodesOld[i][j] = this->_nodes[i][j];
-				}
+			Residual* slots = &residuals[(itterCnt & 1) * nofThreads];
+			++itterCnt;
+			typedef std::chrono::high_resolution_clock clock;
+			const clock::time_point sweepStart = isTraced ? clock::now() : clock::time_point();
+			// a colour only reads the other one, so the strips of one colour are independent
+			prec_t red = this->sorSweep(this->_nodes.data(), 0, omega, rowBegin, rowEnd);
+			const clock::time_point redEnd = isTraced ? clock::now() : clock::time_point();
+			threadPool.barrier().wait();
+			const clock::time_point blackStart = isTraced ? clock::now() : clock::time_point();
+			prec_t black = this->sorSweep(this->_nodes.data(), 1, omega, rowBegin, rowEnd);
+			slots[threadId].diff = std::max(red, black);
+			if (isTraced)
+				slots[threadId].busyTime = (redEnd - sweepStart) + (clock::now() - blackStart);
+			if (threadId == 0)
+				slots[0].isStopped = this->isStopRequested(itterCnt, diff);
+			threadPool.barrier().wait();
 
 			diff = 0.0f;
-			for (uint64_t i = 1; i < nodeY - 1; ++i) {
-				for (uint64_t j = 1; j < nodeX - 1; ++j) {
-					std::lock_guard<std::mutex> guard(myMutex);
-					if (this->_nodes[i][j].second != true) {
-						this->_nodes[i][j].first = (this->_nodesOld[i - 1][j].first +
-													this->_nodesOld[i + 1][j].first +
-											 		this->_nodesOld[i][j - 1].first + 
-											 		this->_nodesOld[i][j + 1].first) / 4;
-						if (diff < std::fabs(this->_nodesOld[i][j].first - this->_nodes[i][j].first)) {
-							diff = std::fabs(this->_nodesOld[i][j].first - this->_nodes[i][j].first);
-						}
-					}
+			for (unsigned int i = 0; i < nofThreads; ++i)
+				diff = std::max(diff, slots[i].diff);
+			if (threadId == 0)
+				this->_residualHistory.push_back(diff);
+			if (isTraced && threadId == 0) {
+				for (unsigned int i = 0; i < nofThreads && i < SweepRecord::maxThreads; ++i)
+					record.threadTimes[i] = slots[i].busyTime;
+				this->publishSweep(record, itterCnt, diff, sweepStart);
+			}
+			// the grid is updated in place, so the others hold off until it is on disk
+			if (this->isCheckpointSweep(itterCnt)) {
+				if (threadId == 0)
+					this->writeCheckpoint(this->_checkpointPath, this->_nodes.data(), itterCnt, diff);
+				threadPool.barrier().wait();
+			}
+			if (slots[0].isStopped)
+				break;
+		}
+		if (threadId == 0)
+			this->_itterCnt = itterCnt;
+	});
+}
+
+template<typename T>
+void Nodes<T>::rowLineSolve(const T* src, T* dst, uint64_t* run, const T* inv, const prec_t& shift,
+		const uint64_t& rowBegin, const uint64_t& rowEnd) const
+{
+	const T diagonal = static_cast<T>(shift - 2);
+	for (uint64_t i = rowBegin; i < rowEnd; ++i) {
+		// forward elimination into dst; walls and heat sources already sit there as their own value
+		uint64_t free = 0;
+		for (uint64_t j = 1; j < this->_nodeX - 1; ++j) {
+			const uint64_t k = this->index(j, i);
+			if (this->_isHeatSource[k]) {
+				free = 0;
+				continue;
+			}
+			run[j] = free++;
+			dst[k] = (diagonal * src[k] + src[k - this->_nodeX] + src[k + this->_nodeX] + dst[k - 1]) * inv[run[j]];
+		}
+		for (uint64_t j = this->_nodeX - 2; j >= 1; --j) {
+			const uint64_t k = this->index(j, i);
+			if (!this->_isHeatSource[k])
+				dst[k] += inv[run[j]] * dst[k + 1];
+		}
+	}
+}
+
+template<typename T>
+void Nodes<T>::columnLineSolve(const T* src, T* dst, const uint32_t* run, const T* inv, const prec_t& shift,
+		const uint64_t& colBegin, const uint64_t& colEnd) const
+{
+	const T diagonal = static_cast<T>(shift - 2);
+	// every column of the strip at once, a row at a time, so the walk stays row-major
+	for (uint64_t i = 1; i < this->_nodeY - 1; ++i) {
+		for (uint64_t k = this->index(colBegin, i); k < this->index(colEnd, i); ++k) {
+			if (!this->_isHeatSource[k])
+				dst[k] = (diagonal * src[k] + src[k - 1] + src[k + 1] + dst[k - this->_nodeX]) * inv[run[k]];
+		}
+	}
+	for (uint64_t i = this->_nodeY - 2; i >= 1; --i) {
+		for (uint64_t k = this->index(colBegin, i); k < this->index(colEnd, i); ++k) {
+			if (!this->_isHeatSource[k])
+				dst[k] += inv[run[k]] * dst[k + this->_nodeX];
+		}
+	}
+}
+
+template<typename T>
+std::vector<prec_t> Nodes<T>::adiShifts(void) const
+{
+	// the 1-D second difference along a line of n interior nodes has its
+	// eigenvalues in [4 sin^2(pi / 2(n + 1)), 4 cos^2(pi / 2(n + 1))]; the
+	// shifts spread geometrically over the union for both directions, so
+	// each one damps its own band of error modes
+	const prec_t pi = std::acos(static_cast<prec_t>(-1));
+	const uint64_t longest = std::max(this->_nodeX, this->_nodeY) - 1;
+	const uint64_t shortest = std::max<uint64_t>(std::min(this->_nodeX, this->_nodeY) - 1, 2);
+	const prec_t low = 4 * std::pow(std::sin(pi / (2 * longest)), 2);
+	const prec_t high = 4 * std::pow(std::cos(pi / (2 * shortest)), 2);
+	const unsigned int nofShifts = std::max(1, static_cast<int>(std::ceil(std::log(high / low) / std::log(adiShiftRatio))) + 1);
+	std::vector<prec_t> shifts(nofShifts);
+	for (unsigned int i = 0; i < nofShifts; ++i)
+		shifts[i] = nofShifts > 1 ? high * std::pow(low / high, static_cast<prec_t>(i) / (nofShifts - 1)) : std::sqrt(low * high);
+	return shifts;
+}
+
+template<typename T>
+void Nodes<T>::calculateADI(const prec_t& epsilon)
+{
+	const unsigned int nofThreads = this->_canUseThreads ? this->getThreadCount() : 1;
+	ThreadPool& threadPool = this->threadPool(nofThreads);
+	this->placeBuffers(threadPool, nofThreads);
+	const std::vector<prec_t> shifts = this->adiShifts();
+	const uint64_t maxRun = std::max(this->_nodeX, this->_nodeY);
+
+	// Thomas on a (-1, 2 + shift, -1) line: the pivot of a free node only
+	// depends on the shift and how many free nodes precede it since the last
+	// fixed one, so one table per shift replaces a factorisation per line
+	std::vector<T> inv(shifts.size() * maxRun);
+	for (uint64_t s = 0; s < shifts.size(); ++s) {
+		T* table = &inv[s * maxRun];
+		table[0] = static_cast<T>(1 / (2 + shifts[s]));
+		for (uint64_t k = 1; k < maxRun; ++k)
+			table[k] = static_cast<T>(1 / (2 + shifts[s] - table[k - 1]));
+	}
+	// rows count their runs as they go, a column needs them on the way back up
+	std::vector<uint32_t> columnRun(this->_nodes.size(), 0);
+	this->noteScratch(inv.size() * sizeof(T) + columnRun.size() * sizeof(uint32_t) +
+		nofThreads * this->_nodeX * sizeof(uint64_t));
+	for (uint64_t j = 1; j < this->_nodeX - 1; ++j) {
+		uint32_t free = 0;
+		for (uint64_t k = this->index(j, 1); k < this->index(j, this->_nodeY - 1); k += this->_nodeX) {
+			if (this->_isHeatSource[k])
+				free = 0;
+			else
+				columnRun[k] = free++;
+		}
+	}
+
+	struct alignas(64) Residual { prec_t diff; bool isStopped; };
+	std::vector<Residual> residuals(nofThreads);
+	const uint64_t rows = this->_nodeY - 2, cols = this->_nodeX - 2;
+	// walls and heat sources are never written, so after this both generations hold them
+	std::copy(this->_nodes.begin(), this->_nodes.end(), this->_nodesOld.begin());
+
+	this->_itterCnt = 0;
+	threadPool.run([&] (const unsigned int threadId) -> void {
+		const uint64_t rowBegin = 1 + rows * threadId / nofThreads;
+		const uint64_t rowEnd = 1 + rows * (threadId + 1) / nofThreads;
+		const uint64_t colBegin = 1 + cols * threadId / nofThreads;
+		const uint64_t colEnd = 1 + cols * (threadId + 1) / nofThreads;
+		std::vector<uint64_t> rowRun(this->_nodeX);
+		T* grid = this->_nodes.data();
+		T* half = this->_nodesOld.data();
+		uint64_t itterCnt = this->_restartItterCnt;
+		prec_t diff = epsilon;
+		while (epsilon <= diff) {
+			// a full cycle of shifts, each an implicit row half-step into half and
+			// an implicit column half-step back; lines of a half-step are independent
+			for (uint64_t s = 0; s < shifts.size(); ++s) {
+				++itterCnt;
+				this->rowLineSolve(grid, half, rowRun.data(), &inv[s * maxRun], shifts[s], rowBegin, rowEnd);
+				threadPool.barrier().wait();
+				this->columnLineSolve(half, grid, columnRun.data(), &inv[s * maxRun], shifts[s], colBegin, colEnd);
+				threadPool.barrier().wait();
+			}
+			// a large shift barely moves the grid, so the cycle is judged by the
+			// plain Jacobi update it leaves behind, not by its last step
+			prec_t changed = 0.0f;
+			for (uint64_t i = rowBegin; i < rowEnd; ++i) {
+				for (uint64_t k = this->index(1, i); k < this->index(this->_nodeX - 1, i); ++k) {
+					if (!this->_isHeatSource[k])
+						changed = std::max<prec_t>(changed, std::fabs((grid[k - this->_nodeX] + grid[k + this->_nodeX] +
+							grid[k - 1] + grid[k + 1]) / 4 - grid[k]));
 				}
 			}
+			residuals[threadId].diff = changed;
+			if (threadId == 0)
+				residuals[0].isStopped = this->isStopRequested(itterCnt, diff);
+			threadPool.barrier().wait();
+			diff = 0.0f;
+			for (unsigned int i = 0; i < nofThreads; ++i)
+				diff = std::max(diff, residuals[i].diff);
+			const bool isStopped = residuals[0].isStopped;
+			// nobody writes the slots again before everyone has read them
+			threadPool.barrier().wait();
+			if (threadId == 0)
+				this->_residualHistory.push_back(diff);
+			if (isStopped)
+				break;
+		}
+		if (threadId == 0)
+			this->_itterCnt = itterCnt;
+	});
+}
+
+template<typename T>
+void Nodes<T>::calculateMultigrid(const prec_t& epsilon)
+{
+	Multigrid<T> multigrid(this->_nodeX, this->_nodeY, this->_isHeatSource.data());
+	multigrid.setSolveControl(this->_control.get());
+	this->noteScratch(multigrid.getBytes());
+	// one count per V-cycle (the nested-iteration start counts as one)
+	this->_itterCnt = multigrid.solve(this->_nodes.data(), epsilon, true);
+	this->_residualHistory = multigrid.getResidualHistory();
+}
+
+template<typename T>
+void Nodes<T>::calculateConjugateGradient(const prec_t& epsilon)
+{
+	ConjugateGradient<T> conjugateGradient(this->_nodeX, this->_nodeY, this->_isHeatSource.data());
+	conjugateGradient.setPreconditioner(this->_preconditioner, this->getRelaxation());
+	conjugateGradient.setSolveControl(this->_control.get());
+	// r, z, p, q and its own copy of the mask
+	this->noteScratch(this->_nodes.size() * (4 * sizeof(T) + 1));
+	this->_itterCnt = conjugateGradient.solve(this->_nodes.data(), epsilon);
+	this->_residualHistory = conjugateGradient.getResidualHistory();
+}
+
+template<typename T>
+void Nodes<T>::calculateTiled(const prec_t& epsilon)
+{
+	this->_itterCnt = 0;
+	// no interior, nothing to tile
+	if (this->_nodeX < 3 || this->_nodeY < 3)
+		return;
+	if (this->_tiling.rows == 0 || this->_tiling.cols == 0 || this->_tiling.steps == 0)
+		this->autotuneTiling();
+
+	ConvergenceCheck check(this->_convergence, epsilon);
+	const uint64_t limit = this->_convergence.maxItterations;
+	std::vector<prec_t> stepDiffs(this->_tiling.steps);
+	std::copy(this->_nodes.begin(), this->_nodes.end(), this->_nodesOld.begin());
+	while (true) {
+		// a block never runs past the iteration budget
+		const unsigned int blockSteps = limit > 0 ?
+			static_cast<unsigned int>(std::min<uint64_t>(this->_tiling.steps, limit - this->_itterCnt)) :
+			this->_tiling.steps;
+		this->tiledBlock(this->_nodes.data(), this->_nodesOld.data(), blockSteps, stepDiffs.data());
+		// plain Jacobi would have stopped at the first sweep below epsilon; if that
+		// happened inside the block, redo it from the untouched source up to there
+		unsigned int steps = blockSteps;
+		for (unsigned int s = 0; s < blockSteps; ++s) {
+			if (stepDiffs[s] < epsilon) {
+				steps = s + 1;
+				break;
+			}
 		}
+		if (steps < blockSteps)
+			this->tiledBlock(this->_nodes.data(), this->_nodesOld.data(), steps, stepDiffs.data());
+		this->_nodes.swap(this->_nodesOld);
+		this->_itterCnt += steps;
+		this->_residualHistory.insert(this->_residualHistory.end(), stepDiffs.begin(), stepDiffs.begin() + steps);
+		if (stepDiffs[steps - 1] < epsilon)
+			break;
+		if (this->isStopRequested(this->_itterCnt, stepDiffs[steps - 1]))
+			break;
+		if (check.isOutOfBudget(this->_itterCnt)) {
+			this->_hasConverged = false;
+			break;
+		}
+	}
+	uint64_t tileBytes = 0;
+	for (const AlignedVector<T>& scratch : this->_tileScratch)
+		tileBytes += scratch.capacity() * sizeof(T);
+	this->noteScratch(tileBytes);
+	this->_tileScratch.clear();
+	this->_tileScratch.shrink_to_fit();
+}
+
+template<typename T>
+void Nodes<T>::calculateOutOfCore(const prec_t& epsilon)
+{
+	const uint64_t nx = this->_nodeX, ny = this->_nodeY, cells = nx * ny;
+	const unsigned int maxSteps = this->_streamSteps;
+	uint64_t bandRows = std::max<uint64_t>(1, std::min<uint64_t>(ny - 2, this->_streamBandRows > 0 ?
+		this->_streamBandRows : std::max<uint64_t>(4 * maxSteps, (4 << 20) / (nx * sizeof(T)))));
+	if (this->_streamCap > 0) {
+		// the buffers below: per band row three grids, two output rows and two masks,
+		// and the halos of three grids and two masks on top
+		const uint64_t perRow = (5 * sizeof(T) + 2) * nx, halos = 2 * maxSteps * (3 * sizeof(T) + 2) * nx;
+		const uint64_t fit = this->_streamCap > halos ? (this->_streamCap - halos) / perRow : 0;
+		if (fit == 0)
+			clog << "Nodes: " << maxSteps << " sweeps per band need more than a memory cap of " << this->_streamCap
+				<< " bytes, streaming one row at a time" << endl;
+		bandRows = std::max<uint64_t>(1, std::min(bandRows, fit));
+	}
+	const uint64_t bands = (ny - 2 + bandRows - 1) / bandRows;
+	this->_streamStats = StreamStats{0, 0, std::chrono::nanoseconds(0), std::chrono::nanoseconds(0),
+		std::chrono::nanoseconds(0), 0, std::chrono::nanoseconds(0)};
+
+	// two generations, both with the walls, then the mask, each on a page boundary;
+	// a store-backed plate is laid out like this already, any other one is spilled
+	const bool isBacked = static_cast<bool>(this->_store);
+	std::shared_ptr<TileStore> store = this->_store;
+	const uint64_t genBytes = isBacked ? this->_storeMask / 2 : (cells * sizeof(T) + 4095) & ~static_cast<uint64_t>(4095);
+	const uint64_t gens[2] = {0, genBytes}, maskOffset = 2 * genBytes;
+	if (isBacked && !store->isValid()) {
+		clog << "Nodes: the plate's store is gone, nothing to solve" << endl;
+		this->_hasConverged = false;
+		return;
+	}
+	if (!isBacked) {
+		store = std::make_shared<TileStore>(this->_streamPath);
+		if (!store->isValid() || !store->reserve(maskOffset + cells) ||
+				!store->write(gens[0], this->_nodes.data(), cells * sizeof(T)) ||
+				!store->write(gens[1], this->_nodes.data(), cells * sizeof(T)) ||
+				!store->write(maskOffset, this->_isHeatSource.data(), cells)) {
+			clog << "Nodes: no store to stream through, solving in memory with Jacobi" << endl;
+			this->_nodesOld.resize(this->_nodes.size());
+			this->noteScratch(0);
+			this->calculateJacobi(epsilon);
+			return;
+		}
+		AlignedVector<T>().swap(this->_nodes);
+		AlignedVector<uint8_t>().swap(this->_isHeatSource);
+		this->_placedThreads = 0;
+	}
+	// a store-backed plate's store carries the totals of its earlier solves
+	const StreamStats ioBefore = store->getStats();
+
+	// a band with a halo as deep as the step count, read into one slot while
+	// the other sweeps; a second halo sized buffer to sweep into and one
+	// output band per slot, written back while the next one sweeps
+	const uint64_t loadRows = std::min<uint64_t>(bandRows + 2 * maxSteps, ny);
+	AlignedVector<T> loads[2], outs[2], work(loadRows * nx);
+	AlignedVector<uint8_t> masks[2];
+	for (unsigned int slot = 0; slot < 2; ++slot) {
+		loads[slot].resize(loadRows * nx);
+		outs[slot].resize(bandRows * nx);
+		masks[slot].resize(loadRows * nx);
+	}
+	this->noteScratch(((3 * loadRows + 2 * bandRows) * sizeof(T) + 2 * loadRows) * nx);
+
+	auto rowsOf = [&] (const uint64_t& band, const unsigned int steps, uint64_t& rowBegin, uint64_t& rowEnd,
+			uint64_t& loadBegin, uint64_t& loadEnd) -> void {
+		rowBegin = 1 + band * bandRows;
+		rowEnd = std::min(rowBegin + bandRows, ny - 1);
+		loadBegin = rowBegin > steps ? rowBegin - steps : 0;
+		loadEnd = std::min<uint64_t>(rowEnd + steps, ny);
+	};
+	auto load = [&] (const uint64_t& src, const uint64_t& band, const unsigned int steps) -> bool {
+		uint64_t rowBegin, rowEnd, loadBegin, loadEnd;
+		rowsOf(band, steps, rowBegin, rowEnd, loadBegin, loadEnd);
+		return store->read(src + loadBegin * nx * sizeof(T), loads[band & 1].data(), (loadEnd - loadBegin) * nx * sizeof(T)) &&
+			store->read(maskOffset + loadBegin * nx, masks[band & 1].data(), (loadEnd - loadBegin) * nx);
 	};
+	auto save = [&] (const uint64_t& dst, const uint64_t& band) -> bool {
+		uint64_t rowBegin, rowEnd, loadBegin, loadEnd;
+		rowsOf(band, 0, rowBegin, rowEnd, loadBegin, loadEnd);
+		return store->write(dst + rowBegin * nx * sizeof(T), outs[band & 1].data(), (rowEnd - rowBegin) * nx * sizeof(T));
+	};
+	// the same shrinking halo as tiledBlock, over whole rows
+	auto sweep = [&] (const uint64_t& band, const unsigned int steps, prec_t* stepDiffs) -> void {
+		uint64_t rowBegin, rowEnd, loadBegin, loadEnd;
+		rowsOf(band, steps, rowBegin, rowEnd, loadBegin, loadEnd);
+		T* cur = loads[band & 1].data();
+		T* next = work.data();
+		T* out = outs[band & 1].data();
+		const uint8_t* mask = masks[band & 1].data();
+		// what no step writes: the wall columns, and the wall rows inside the halo
+		for (uint64_t i = loadBegin; i < loadEnd; ++i) {
+			const T* in = cur + (i - loadBegin) * nx;
+			if (i == 0 || i == ny - 1) {
+				std::copy(in, in + nx, next + (i - loadBegin) * nx);
+				continue;
+			}
+			next[(i - loadBegin) * nx] = in[0];
+			next[(i - loadBegin) * nx + nx - 1] = in[nx - 1];
+			if (rowBegin <= i && i < rowEnd) {
+				out[(i - rowBegin) * nx] = in[0];
+				out[(i - rowBegin) * nx + nx - 1] = in[nx - 1];
+			}
+		}
+		for (unsigned int s = 1; s <= steps; ++s) {
+			const uint64_t iBegin = std::max<uint64_t>(1, rowBegin + s > steps ? rowBegin + s - steps : 0);
+			const uint64_t iEnd = std::min<uint64_t>(ny - 1, rowEnd + steps - s);
+			const bool isLast = s == steps;
+			for (uint64_t i = iBegin; i < iEnd; ++i) {
+				const T* row = cur + (i - loadBegin) * nx;
+				T* dst = isLast ? out + (i - rowBegin) * nx : next + (i - loadBegin) * nx;
+				const prec_t diff = Kernels::jacobiRow(row - nx, row, row + nx, mask + (i - loadBegin) * nx,
+					dst, 1, nx - 1);
+				if (rowBegin <= i && i < rowEnd)
+					stepDiffs[s - 1] = std::max(stepDiffs[s - 1], diff);
+			}
+			std::swap(cur, next);
+		}
+	};
+	// every band once, steps sweeps each; the store thread writes band b - 1
+	// and reads band b + 1 while band b sweeps
+	auto pass = [&] (const uint64_t& src, const uint64_t& dst, const unsigned int steps, prec_t* stepDiffs) -> bool {
+		std::fill(stepDiffs, stepDiffs + steps, static_cast<prec_t>(0));
+		++(this->_streamStats.passes);
+		std::future<bool> io = std::async(std::launch::async, load, src, 0, steps);
+		for (uint64_t band = 0; band < bands; ++band) {
+			const auto waitStart = std::chrono::steady_clock::now();
+			const bool isOk = io.get();
+			this->_streamStats.stallTime += std::chrono::steady_clock::now() - waitStart;
+			if (!isOk)
+				return false;
+			io = std::async(std::launch::async, [&, band] () -> bool {
+				const bool isSaved = band == 0 || save(dst, band - 1);
+				return (band + 1 == bands || load(src, band + 1, steps)) && isSaved;
+			});
+			sweep(band, steps, stepDiffs);
+		}
+		return io.get() && save(dst, bands - 1);
+	};
+
+	std::vector<prec_t> stepDiffs(maxSteps);
+	const uint64_t limit = this->_convergence.maxItterations;
+	unsigned int src = isBacked && this->_storeGen == genBytes ? 1 : 0;
+	bool isOk = true;
+	this->_itterCnt = 0;
+	const auto passStart = std::chrono::steady_clock::now();
+	while (true) {
+		const unsigned int passSteps = limit > 0 ?
+			static_cast<unsigned int>(std::min<uint64_t>(maxSteps, limit - this->_itterCnt)) : maxSteps;
+		isOk = pass(gens[src], gens[src ^ 1], passSteps, stepDiffs.data());
+		// as in calculateTiled: a pass that went below epsilon before its last
+		// sweep is run again from the untouched source generation up to there
+		unsigned int steps = passSteps;
+		for (unsigned int s = 0; s < passSteps && isOk; ++s) {
+			if (stepDiffs[s] < epsilon) {
+				steps = s + 1;
+				break;
+			}
+		}
+		if (isOk && steps < passSteps)
+			isOk = pass(gens[src], gens[src ^ 1], steps, stepDiffs.data());
+		if (!isOk)
+			break;
+		src ^= 1;
+		this->_itterCnt += steps;
+		this->_residualHistory.insert(this->_residualHistory.end(), stepDiffs.begin(), stepDiffs.begin() + steps);
+		if (stepDiffs[steps - 1] < epsilon)
+			break;
+		if (this->isStopRequested(this->_itterCnt, stepDiffs[steps - 1]))
+			break;
+		if (limit > 0 && this->_itterCnt >= limit) {
+			this->_hasConverged = false;
+			break;
+		}
+	}
+	this->_streamStats.passTime = std::chrono::steady_clock::now() - passStart;
+
+	// a failed pass never got to swap, its source generation is still whole
+	if (!isOk)
+		clog << "Nodes: the store failed after " << this->_itterCnt << " sweeps, keeping the last whole one" << endl;
+	if (isBacked) {
+		this->_storeGen = gens[src];
+	} else {
+		this->_nodes.resize(cells);
+		this->_isHeatSource.resize(cells);
+		if (!store->read(gens[src], this->_nodes.data(), cells * sizeof(T)) ||
+				!store->read(maskOffset, this->_isHeatSource.data(), cells)) {
+			clog << "Nodes: cannot read the grid back from the store" << endl;
+			isOk = false;
+		}
+	}
+	if (!isOk)
+		this->_hasConverged = false;
+	const StreamStats io = store->getStats();
+	this->_streamStats.bytesRead = io.bytesRead - ioBefore.bytesRead;
+	this->_streamStats.bytesWritten = io.bytesWritten - ioBefore.bytesWritten;
+	this->_streamStats.readTime = io.readTime - ioBefore.readTime;
+	this->_streamStats.writeTime = io.writeTime - ioBefore.writeTime;
+}
+
+template<typename T>
+void Nodes<T>::tiledBlock(const T* src, T* dst, const unsigned int steps, prec_t* stepDiffs)
+{
+	const unsigned int nofThreads = this->_canUseThreads ? this->getThreadCount() : 1;
+	ThreadPool& threadPool = this->threadPool(nofThreads);
+	const uint64_t nx = this->_nodeX, ny = this->_nodeY;
+	const uint64_t tileRows = std::min<uint64_t>(this->_tiling.rows, ny - 2);
+	const uint64_t tileCols = std::min<uint64_t>(this->_tiling.cols, nx - 2);
+	if (tileRows == 0 || tileCols == 0) {
+		std::fill(stepDiffs, stepDiffs + steps, static_cast<prec_t>(0));
+		return;
+	}
+	const uint64_t tilesY = (ny - 2 + tileRows - 1) / tileRows, tilesX = (nx - 2 + tileCols - 1) / tileCols;
+	const uint64_t stride = tileCols + 2 * steps;
+	std::vector<std::vector<prec_t>> threadDiffs(nofThreads, std::vector<prec_t>(steps, 0));
+	// a tile plus a halo as deep as the step count, two per thread, kept
+	// across blocks so the pages are only faulted in once
+	this->_tileScratch.resize(2 * nofThreads);
+	for (auto& i : this->_tileScratch)
+		if (i.size() < (tileRows + 2 * steps) * stride)
+			i.resize((tileRows + 2 * steps) * stride);
+
+	threadPool.run([&] (const unsigned int threadId) -> void {
+		T* bufA = this->_tileScratch[2 * threadId].data();
+		T* bufB = this->_tileScratch[2 * threadId + 1].data();
+		prec_t* diffs = threadDiffs[threadId].data();
+		for (uint64_t tile = threadId; tile < tilesY * tilesX; tile += nofThreads) {
+			const uint64_t rowBegin = 1 + (tile / tilesX) * tileRows, rowEnd = std::min(rowBegin + tileRows, ny - 1);
+			const uint64_t colBegin = 1 + (tile % tilesX) * tileCols, colEnd = std::min(colBegin + tileCols, nx - 1);
+			const uint64_t loadRowBegin = rowBegin > steps ? rowBegin - steps : 0;
+			const uint64_t loadRowEnd = std::min<uint64_t>(rowEnd + steps, ny);
+			const uint64_t loadColBegin = colBegin > steps ? colBegin - steps : 0;
+			const uint64_t loadColEnd = std::min<uint64_t>(colEnd + steps, nx);
+			const uint64_t width = loadColEnd - loadColBegin;
+
+			// the second buffer only needs what no step writes: walls inside the halo
+			for (uint64_t i = loadRowBegin; i < loadRowEnd; ++i) {
+				const T* in = src + i * nx + loadColBegin;
+				std::copy(in, in + width, bufA + (i - loadRowBegin) * stride);
+				if (i == 0 || i == ny - 1) {
+					std::copy(in, in + width, bufB + (i - loadRowBegin) * stride);
+				} else {
+					if (loadColBegin == 0)
+						bufB[(i - loadRowBegin) * stride] = in[0];
+					if (loadColEnd == nx)
+						bufB[(i - loadRowBegin) * stride + width - 1] = in[width - 1];
+				}
+			}
+			T* cur = bufA;
+			T* next = bufB;
+
+			// the valid region shrinks by one node per step on every side, the
+			// last step covers exactly the tile and writes straight into dst
+			for (unsigned int s = 1; s <= steps; ++s) {
+				const uint64_t iBegin = std::max<uint64_t>(1, rowBegin + s > steps ? rowBegin + s - steps : 0);
+				const uint64_t iEnd = std::min<uint64_t>(ny - 1, rowEnd + steps - s);
+				const uint64_t jBegin = std::max<uint64_t>(1, colBegin + s > steps ? colBegin + s - steps : 0);
+				const uint64_t jEnd = std::min<uint64_t>(nx - 1, colEnd + steps - s);
+				const bool isLast = s == steps;
+				for (uint64_t i = iBegin; i < iEnd; ++i) {
+					const T* row = cur + (i - loadRowBegin) * stride;
+					T* out = isLast ? dst + i * nx + loadColBegin : next + (i - loadRowBegin) * stride;
+					const prec_t diff = Kernels::jacobiRow(row - stride, row, row + stride,
+						&this->_isHeatSource[this->index(loadColBegin, i)], out,
+						jBegin - loadColBegin, jEnd - loadColBegin);
+					if (rowBegin <= i && i < rowEnd)
+						diffs[s - 1] = std::max(diffs[s - 1], diff);
+				}
+				std::swap(cur, next);
+			}
+		}
+	});
+
+	// the halo rows recompute nodes another tile owns, so only owned rows count
+	// above; owned columns are implied since the last step covers exactly them
+	for (unsigned int s = 0; s < steps; ++s) {
+		stepDiffs[s] = 0.0f;
+		for (unsigned int i = 0; i < nofThreads; ++i)
+			stepDiffs[s] = std::max(stepDiffs[s], threadDiffs[i][s]);
+	}
+}
+
+template<typename T>
+void Nodes<T>::autotuneTiling(void)
+{
+	// a store-backed plate only ever streams, there is nothing to tile
+	if (this->_store)
+		return;
+	const uint64_t rows = this->_nodeY > 2 ? this->_nodeY - 2 : 1, cols = this->_nodeX > 2 ? this->_nodeX - 2 : 1;
+	long l2 = sysconf(_SC_LEVEL2_CACHE_SIZE);
+	if (l2 <= 0)
+		l2 = 1 << 20;
+
+	if (this->_nodeX * this->_nodeY * sizeof(T) * 2 <= static_cast<uint64_t>(l2)) {
+		// the plate is cache resident already, one tile avoids all redundant work
+		this->_tiling = TileShape{rows, cols, 8};
+		return;
+	}
 
-	clog << "main tread [id: " << std::this_thread::get_id() << "]" << endl; 
-	for (unsigned int i = 0; i < nofCore; ++i) {
-		if (this->_nodeY > this->_nodeX) {
-			threads[i] = std::thread(calc, this->_nodeX, (this->_nodeY / nofCore) * (i + 1), epsilon);
+	// two tile buffers in half of L2, as square as the plate allows; keep the
+	// halo within a quarter of the side and time one block per step count
+	const uint64_t side = static_cast<uint64_t>(std::sqrt(static_cast<double>(l2) / 2 / (2 * sizeof(T))));
+	AlignedVector<T> src(this->_nodes), dst(this->_nodes);
+	TileShape best{rows, cols, 1};
+	double bestRate = 0;
+	for (unsigned int steps = 2; 8 * steps <= side && steps <= 32; steps *= 2) {
+		std::vector<prec_t> stepDiffs(steps);
+		this->_tiling = TileShape{std::min(side - 2 * steps, rows), std::min(side - 2 * steps, cols), steps};
+		// first run faults the scratch in, the second one is timed
+		this->tiledBlock(src.data(), dst.data(), steps, stepDiffs.data());
+		const auto start = std::chrono::high_resolution_clock::now();
+		this->tiledBlock(src.data(), dst.data(), steps, stepDiffs.data());
+		const std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+		if (steps / elapsed.count() > bestRate) {
+			bestRate = steps / elapsed.count();
+			best = this->_tiling;
+		}
+	}
+	this->_tiling = best;
+}
+
+template<typename T> template<typename L>
+void Nodes<T>::calculateMixed(const prec_t& epsilon)
+{
+	const uint64_t size = this->_nodeX * this->_nodeY;
+	AlignedVector<L> cur(size), next(size), rhs;
+	this->_lowSweeps = 0;
+	this->_highSweeps = 0;
+
+	// plain Jacobi in L until it reaches epsilon or stops improving; the floor
+	// is a few ulps of the largest temperature, below that L only adds noise
+	T maxTemp = 0;
+	for (uint64_t k = 0; k < size; ++k) {
+		cur[k] = static_cast<L>(this->_nodes[k]);
+		maxTemp = std::max<T>(maxTemp, std::fabs(this->_nodes[k]));
+	}
+	next = cur;
+	const prec_t floor = 8 * std::numeric_limits<L>::epsilon() * static_cast<prec_t>(maxTemp);
+	prec_t diff = epsilon, best = std::numeric_limits<prec_t>::max();
+	uint64_t sinceBest = 0;
+	while (epsilon <= diff && floor < diff && sinceBest < 64) {
+		diff = this->lowSweep(cur.data(), next.data(), static_cast<const L*>(nullptr));
+		cur.swap(next);
+		++(this->_lowSweeps);
+		this->_residualHistory.push_back(diff);
+		if (this->isStopRequested(this->_lowSweeps, diff))
+			break;
+		if (diff < best) {
+			best = diff;
+			sinceBest = 0;
 		} else {
-			threads[i] = std::thread(calc, (this->_nodeX / nofCore) * (i + 1), this->_nodeY, epsilon);
+			++sinceBest;
 		}
 	}
-	for (unsigned int i = 0; i < nofCore; ++i)
-		threads[i].join();
+	for (uint64_t k = 0; k < size; ++k)
+		if (!this->_isHeatSource[k])
+			this->_nodes[k] = static_cast<T>(cur[k]);
+
+	// defect correction: the defect r = (N + S + E + W) / 4 - u is evaluated in T
+	// (it is exactly the change a T Jacobi sweep would make), the correction
+	// e = (N + S + E + W)(e) / 4 + r is solved in L and added back in T
+	AlignedVector<T> defect(size, 0);
+	rhs.assign(size, 0);
+	this->noteScratch(3 * size * sizeof(L) + size * sizeof(T));
+	while (true) {
+		++(this->_highSweeps);
+		diff = 0.0f;
+		for (uint64_t i = 1; i < this->_nodeY - 1; ++i) {
+			for (uint64_t j = 1; j < this->_nodeX - 1; ++j) {
+				const uint64_t k = this->index(j, i);
+				if (this->_isHeatSource[k])
+					continue;
+				defect[k] = (this->_nodes[k - this->_nodeX] + this->_nodes[k + this->_nodeX] +
+							 this->_nodes[k - 1] + this->_nodes[k + 1]) / 4 - this->_nodes[k];
+				diff = std::max<prec_t>(diff, std::fabs(defect[k]));
+			}
+		}
+		this->_residualHistory.push_back(diff);
+		if (diff < epsilon || this->isStopRequested(this->_lowSweeps + this->_highSweeps, diff))
+			break;
+
+		for (uint64_t k = 0; k < size; ++k) {
+			rhs[k] = static_cast<L>(defect[k]);
+			cur[k] = 0;
+			next[k] = 0;
+		}
+		// the correction only has to be good to a fraction of epsilon, or as
+		// good as L gets relative to the defect it corrects
+		const prec_t innerFloor = std::max<prec_t>(epsilon / 4, 8 * std::numeric_limits<L>::epsilon() * diff);
+		prec_t innerDiff = innerFloor;
+		best = std::numeric_limits<prec_t>::max();
+		sinceBest = 0;
+		while (innerFloor <= innerDiff && sinceBest < 64) {
+			innerDiff = this->lowSweep(cur.data(), next.data(), rhs.data());
+			cur.swap(next);
+			++(this->_lowSweeps);
+			// a partial correction still improves the grid, it is added all the same
+			if (this->isStopRequested(this->_lowSweeps + this->_highSweeps, diff))
+				break;
+			if (innerDiff < best) {
+				best = innerDiff;
+				sinceBest = 0;
+			} else {
+				++sinceBest;
+			}
+		}
+		for (uint64_t k = 0; k < size; ++k)
+			this->_nodes[k] += static_cast<T>(cur[k]);
+	}
+	this->_itterCnt = this->_lowSweeps + this->_highSweeps;
+}
+
+template<typename T> template<typename L>
+prec_t Nodes<T>::lowSweep(const L* src, L* dst, const L* rhs) const
+{
+	if (!rhs) {
+		prec_t diff = 0.0f;
+		for (uint64_t i = 1; i < this->_nodeY - 1; ++i) {
+			diff = std::max(diff, Kernels::jacobiRow(src + this->index(0, i - 1), src + this->index(0, i),
+				src + this->index(0, i + 1), &this->_isHeatSource[this->index(0, i)],
+				dst + this->index(0, i), 1, this->_nodeX - 1));
+		}
+		return diff;
+	}
+	L diff = 0;
+	for (uint64_t i = 1; i < this->_nodeY - 1; ++i) {
+		const L* north = src + this->index(0, i - 1);
+		const L* row = src + this->index(0, i);
+		const L* south = src + this->index(0, i + 1);
+		const L* f = rhs + this->index(0, i);
+		const uint8_t* isHeatSource = &this->_isHeatSource[this->index(0, i)];
+		L* out = dst + this->index(0, i);
+		for (uint64_t j = 1; j < this->_nodeX - 1; ++j) {
+			const L temp = (north[j] + south[j] + row[j - 1] + row[j + 1]) / 4 + f[j];
+			out[j] = isHeatSource[j] ? row[j] : temp;
+			diff = std::max<L>(diff, std::fabs(row[j] - out[j]));
+		}
+	}
+	return diff;
+}
+
+template<typename T>
+ThreadPool& Nodes<T>::threadPool(const unsigned int nofThreads)
+{
+	if (!this->_threadPool || this->_threadPool->size() != nofThreads)
+		this->_threadPool = std::make_shared<ThreadPool>(nofThreads);
+	return *(this->_threadPool);
+}
+
+template<typename T>
+void Nodes<T>::placeBuffers(ThreadPool& threadPool, const unsigned int nofThreads)
+{
+	const GridMemoryPolicy policy = GridMemory::getPolicy();
+	if (nofThreads < 2 || !(policy.firstTouch || policy.pinWorkers))
+		return;
+	// the generations swap every sweep, either order is the same layout
+	const void* nodes = this->_nodes.data();
+	const void* nodesOld = this->_nodesOld.data();
+	if (this->_placedThreads == nofThreads && this->_placedGrids[2] == this->_isHeatSource.data() &&
+			((this->_placedGrids[0] == nodes && this->_placedGrids[1] == nodesOld) ||
+			(this->_placedGrids[0] == nodesOld && this->_placedGrids[1] == nodes)))
+		return;
+	const uint64_t rows = this->_nodeY - 2;
+	threadPool.run([&] (const unsigned int threadId) -> void {
+		// worker 0 is the caller's own thread, that one is left where it is
+		if (policy.pinWorkers && threadId > 0)
+			GridMemory::pinThread(threadId);
+		if (!policy.firstTouch)
+			return;
+		// the band the sweeps give this worker, the walls go with the first and last
+		const uint64_t rowBegin = threadId == 0 ? 0 : 1 + rows * threadId / nofThreads;
+		const uint64_t rowEnd = threadId + 1 == nofThreads ? this->_nodeY : 1 + rows * (threadId + 1) / nofThreads;
+		const uint64_t first = this->index(0, rowBegin), count = (rowEnd - rowBegin) * this->_nodeX;
+		GridMemory::place(this->_nodes.data() + first, count * sizeof(T));
+		if (!this->_nodesOld.empty())
+			GridMemory::place(this->_nodesOld.data() + first, count * sizeof(T));
+		GridMemory::place(this->_isHeatSource.data() + first, count);
+	});
+	this->_placedGrids[0] = nodes;
+	this->_placedGrids[1] = nodesOld;
+	this->_placedGrids[2] = this->_isHeatSource.data();
+	this->_placedThreads = nofThreads;
 }
 
 template<typename T>
 T Nodes<T>::getTemp(const uint64_t& posX, const uint64_t& posY) const
 {
 	if (this->_hasCalculated)
-		return this->_nodes[posY][posX].first;
+		return this->nodeAt(this->index(posX, posY));
 	else {
 		//!TODO implement error handling or error throw mechanism
 		return 0;
@@ -257,10 +2008,40 @@ T Nodes<T>::getTemp(const uint64_t& posX, const uint64_t& posY) const
 template<typename T>
 std::ostream& operator<<(std::ostream& os, const Nodes<T>& obj)
 {
-	for (const auto& i : obj._nodes) {
-		for (const auto& node : i)
-			os << node.first << ", ";
-		os << endl;
+	// fixed notation goes through formatFixed into one large buffer; rows end
+	// in '\n', so nothing flushes the stream once per row. Anything formatFixed
+	// does not do (padding, signs, upper case, a point without decimals, more
+	// than 18 decimals) goes through the stream as it always did
+	const std::ios::fmtflags custom = std::ios::showpos | std::ios::uppercase | std::ios::showpoint;
+	std::vector<T> chunk;
+	uint64_t chunkBegin = 0;
+	if ((os.flags() & std::ios::floatfield) == std::ios::fixed && !(os.flags() & custom) &&
+			os.width() == 0 && os.precision() <= 18) {
+		const unsigned int precision = static_cast<unsigned int>(std::max<std::streamsize>(os.precision(), 0));
+		const uint64_t flushAt = std::min(static_cast<uint64_t>(ResultWriter::bufferSize), obj._nodeX * obj._nodeY * 32);
+		std::vector<char> buffer(flushAt + ResultWriter::maxFieldWidth + 3);
+		uint64_t used = 0;
+		for (uint64_t i = 0; i < obj._nodeY; ++i) {
+			const T* row = obj.rowAt(i, chunk, chunkBegin);
+			for (uint64_t j = 0; row && j < obj._nodeX; ++j) {
+				used += ResultWriter::formatFixed(row[j], precision, buffer.data() + used);
+				buffer[used++] = ',';
+				buffer[used++] = ' ';
+				if (used >= flushAt) {
+					os.write(buffer.data(), used);
+					used = 0;
+				}
+			}
+			buffer[used++] = '\n';
+		}
+		os.write(buffer.data(), used);
+	} else {
+		for (uint64_t i = 0; i < obj._nodeY; ++i) {
+			const T* row = obj.rowAt(i, chunk, chunkBegin);
+			for (uint64_t j = 0; row && j < obj._nodeX; ++j)
+				os << row[j] << ", ";
+			os << '\n';
+		}
 	}
 	return os;
 }
@@ -40,8 +40,6 @@ using std::cin;
 using std::clog;
 using std::make_pair;
 
-using prec_t = long double;
-
 namespace HMT
 {
 
@@ -75,7 +73,7 @@ void NodesHelper<T>::init(void)
 	cin >> this->_tempWest;
 
 	this->_nodeX = this->_lenX / this->_dX;
-	this->_nodeY = this->_lenY / this->_dX;
+	this->_nodeY = this->_lenY / this->_dY;
 	clog << "[nodeX: " << this->_nodeX << "]" << endl;
 	clog << "[nodeY: " << this->_nodeY << "]" << endl;
 
@@ -118,6 +116,38 @@ void NodesHelper<T>::init(void)
 	cout << "Input Section END from NodesHelper  ##########" << endl << endl;
 }
 
+template<typename T>
+void NodesHelper<T>::init(const JobSpec<T>& job)
+{
+	this->_lenX = job.lenX;
+	this->_lenY = job.lenY;
+	this->_dX = job.dX;
+	this->_dY = job.dY;
+	this->_tempNorth = job.tempNorth;
+	this->_tempEast = job.tempEast;
+	this->_tempSouth = job.tempSouth;
+	this->_tempWest = job.tempWest;
+	this->_nodeX = this->_lenX / this->_dX;
+	this->_nodeY = this->_lenY / this->_dY;
+	this->_canUseThreads = job.threadCnt != 1;
+	this->_calculated = false;
+
+	this->_nodes = Nodes<T>(this->_nodeX, this->_nodeY);
+	this->_nodes.canUseThreads(this->_canUseThreads);
+	this->_nodes.setThreadCount(job.threadCnt);
+	this->_nodes.setProcessCount(job.threadCnt);
+	this->_nodes.setSolverMode(job.solverMode);
+	this->_nodes.setWallTemp(this->_tempNorth, this->_tempEast, this->_tempSouth, this->_tempWest);
+
+	this->_heatSources.assign(job.heatSources.begin(), job.heatSources.end());
+	for (const std::pair<std::pair<uint64_t, uint64_t>, T>& i : this->_heatSources) {
+		this->_nodes.setHeatSource(
+			i.first.first,
+			i.first.second,
+			i.second);
+	}
+}
+
 template<typename T>
 void NodesHelper<T>::addHeatSource(std::initializer_list<std::pair<std::pair<uint64_t, uint64_t>, T>>& lst)
 {
@@ -150,10 +180,28 @@ void NodesHelper<T>::calculate(void)
 	cout << "Enter value of Epsilon: ";
 	cin >> epsilon;
 
+	this->calculate(epsilon);
+}
+
+template<typename T>
+void NodesHelper<T>::calculate(const prec_t epsilon)
+{
 	this->_nodes.calculate(epsilon);
 	this->_calculated = true;
 }
 
+template<typename T>
+SolveHandle<T> NodesHelper<T>::calculateAsync(const prec_t epsilon, const SolveControl::clock::time_point& deadline)
+{
+	return AsyncSolver<T>::shared().submit(this->_nodes, epsilon, deadline);
+}
+
+template<typename T>
+const Nodes<T>& NodesHelper<T>::getNodes(void) const noexcept(true)
+{
+	return this->_nodes;
+}
+
 template<typename T> template<typename durationFormat>
 durationFormat NodesHelper<T>::getDuration() const
 {
@@ -163,14 +211,7 @@ durationFormat NodesHelper<T>::getDuration() const
 template<typename T>
 std::ostream& operator<<(std::ostream& os, const NodesHelper<T>& obj)
 {
-	for (uint64_t i = 0; i < obj._nodeX; ++i) {
-		for (uint64_t j = 0; j < obj._nodeY; ++j) {
-			cout << obj._nodes.getTemp(i, j) << ", ";
-		}
-		cout << endl;
-	}
-
-	return os;
+	return os << obj._nodes;
 }
 
 }
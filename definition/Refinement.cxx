@@ -0,0 +1,366 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+#ifndef REFINEMENT_CXX
+#define REFINEMENT_CXX
+
+#include <vector>
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "../header/Refinement.h"
+
+namespace HMT
+{
+
+template<typename T>
+RefinedNodes<T>::RefinedNodes(const uint64_t& nodeX, const uint64_t& nodeY): _nodeX(nodeX), _nodeY(nodeY),
+	_box{0, 0, nodeX - 1, nodeY - 1}, _ratio(1), _solverMode(SolverMode::Jacobi),
+	_maxCouplings(100), _couplingCnt(0), _hasConverged(true), _hasGuess(true),
+	_nodes(nodeX, nodeY), _isHeatSource(nodeX * nodeY, 0)
+{
+	// every coupling iteration re-solves from the last field
+	this->_nodes.setWarmStart(true);
+}
+
+template<typename T>
+RefinedNodes<T>::RefinedNodes(const RefinedNodes<T>& parent, const PatchBox& box, const unsigned int ratio):
+	_nodeX((box.x1 - box.x0) * ratio + 1), _nodeY((box.y1 - box.y0) * ratio + 1), _box(box), _ratio(ratio),
+	_solverMode(parent._solverMode), _maxCouplings(parent._maxCouplings), _couplingCnt(0),
+	_hasConverged(true), _hasGuess(false), _nodes(_nodeX, _nodeY), _isHeatSource(_nodeX * _nodeY, 0)
+{
+	this->_nodes.setWarmStart(true);
+	this->_nodes.setSolverMode(this->_solverMode);
+	for (const auto& i : parent._heatSources) {
+		const uint64_t posX = i.first.first, posY = i.first.second;
+		if (posX >= box.x0 && posX <= box.x1 && posY >= box.y0 && posY <= box.y1)
+			this->setHeatSource((posX - box.x0) * ratio, (posY - box.y0) * ratio, i.second);
+	}
+}
+
+template<typename T>
+void RefinedNodes<T>::setWallTemp(const T& northTemp, const T& eastTemp, const T& southTemp, const T& westTemp)
+{
+	this->_nodes.setWallTemp(northTemp, eastTemp, southTemp, westTemp);
+	// walls overwrite corner and edge heat sources, put them back
+	for (const auto& i : this->_heatSources)
+		this->_nodes.setHeatSource(i.first.first, i.first.second, i.second);
+}
+
+template<typename T>
+void RefinedNodes<T>::setHeatSource(const uint64_t& posX, const uint64_t& posY, const T& temp)
+{
+	this->_nodes.setHeatSource(posX, posY, temp);
+	this->_heatSources.push_back(std::make_pair(std::make_pair(posX, posY), temp));
+	this->_isHeatSource[posY * this->_nodeX + posX] = 1;
+	for (const auto& patch : this->_patches) {
+		const PatchBox& box = patch->_box;
+		if (posX >= box.x0 && posX <= box.x1 && posY >= box.y0 && posY <= box.y1)
+			patch->setHeatSource((posX - box.x0) * patch->_ratio, (posY - box.y0) * patch->_ratio, temp);
+	}
+}
+
+template<typename T>
+void RefinedNodes<T>::setSolverMode(const SolverMode mode)
+{
+	this->_solverMode = mode;
+	this->_nodes.setSolverMode(mode);
+	for (const auto& patch : this->_patches)
+		patch->setSolverMode(mode);
+}
+
+template<typename T>
+void RefinedNodes<T>::setMaxCouplings(const uint64_t& maxCouplings)
+{
+	this->_maxCouplings = maxCouplings;
+	for (const auto& patch : this->_patches)
+		patch->setMaxCouplings(maxCouplings);
+}
+
+template<typename T>
+RefinedNodes<T>* RefinedNodes<T>::addPatch(const PatchBox& box, const unsigned int ratio)
+{
+	if (ratio < 2 || box.x0 >= box.x1 || box.y0 >= box.y1 || box.x1 >= this->_nodeX ||
+			box.y1 >= this->_nodeY || !this->isFree(box))
+		return nullptr;
+	this->_patches.push_back(std::unique_ptr<RefinedNodes<T>>(new RefinedNodes<T>(*this, box, ratio)));
+	return this->_patches.back().get();
+}
+
+template<typename T>
+uint64_t RefinedNodes<T>::refineAroundHeatSources(const uint64_t& radius, const unsigned int ratio)
+{
+	std::vector<PatchBox> boxes;
+	for (const auto& i : this->_heatSources) {
+		const uint64_t posX = i.first.first, posY = i.first.second;
+		boxes.push_back(PatchBox{posX > radius ? posX - radius : 0, posY > radius ? posY - radius : 0,
+			std::min(posX + radius, this->_nodeX - 1), std::min(posY + radius, this->_nodeY - 1)});
+	}
+	return this->addPatches(boxes, ratio);
+}
+
+template<typename T>
+uint64_t RefinedNodes<T>::refineGradient(const prec_t& threshold, const uint64_t& margin, const unsigned int ratio,
+		const prec_t& epsilon)
+{
+	this->calculate(epsilon);
+	std::vector<uint8_t> isFlagged(this->_nodeX * this->_nodeY, 0);
+	for (uint64_t i = 1; i < this->_nodeY - 1; ++i) {
+		for (uint64_t j = 1; j < this->_nodeX - 1; ++j) {
+			const prec_t gradX = (this->_nodes.getTemp(j + 1, i) - this->_nodes.getTemp(j - 1, i)) / 2.0f;
+			const prec_t gradY = (this->_nodes.getTemp(j, i + 1) - this->_nodes.getTemp(j, i - 1)) / 2.0f;
+			isFlagged[i * this->_nodeX + j] = std::sqrt(gradX * gradX + gradY * gradY) > threshold;
+		}
+	}
+
+	// one box per 8-connected cluster of flagged nodes
+	std::vector<PatchBox> boxes;
+	std::vector<uint64_t> stack;
+	for (uint64_t k = 0; k < isFlagged.size(); ++k) {
+		if (!isFlagged[k])
+			continue;
+		PatchBox box{k % this->_nodeX, k / this->_nodeX, k % this->_nodeX, k / this->_nodeX};
+		isFlagged[k] = 0;
+		stack.push_back(k);
+		while (!stack.empty()) {
+			const uint64_t posX = stack.back() % this->_nodeX, posY = stack.back() / this->_nodeX;
+			stack.pop_back();
+			box = PatchBox{std::min(box.x0, posX), std::min(box.y0, posY), std::max(box.x1, posX), std::max(box.y1, posY)};
+			for (uint64_t y = posY - 1; y <= posY + 1; ++y) {
+				for (uint64_t x = posX - 1; x <= posX + 1; ++x) {
+					if (isFlagged[y * this->_nodeX + x]) {
+						isFlagged[y * this->_nodeX + x] = 0;
+						stack.push_back(y * this->_nodeX + x);
+					}
+				}
+			}
+		}
+		boxes.push_back(PatchBox{box.x0 > margin ? box.x0 - margin : 0, box.y0 > margin ? box.y0 - margin : 0,
+			std::min(box.x1 + margin, this->_nodeX - 1), std::min(box.y1 + margin, this->_nodeY - 1)});
+	}
+	return this->addPatches(boxes, ratio);
+}
+
+template<typename T>
+uint64_t RefinedNodes<T>::addPatches(std::vector<PatchBox> boxes, const unsigned int ratio)
+{
+	// siblings may not overlap, so boxes that do become their bounding box
+	bool isMerged = true;
+	while (isMerged) {
+		isMerged = false;
+		for (uint64_t a = 0; a < boxes.size() && !isMerged; ++a) {
+			for (uint64_t b = a + 1; b < boxes.size() && !isMerged; ++b) {
+				if (boxes[a].x0 > boxes[b].x1 || boxes[b].x0 > boxes[a].x1 ||
+						boxes[a].y0 > boxes[b].y1 || boxes[b].y0 > boxes[a].y1)
+					continue;
+				boxes[a] = PatchBox{std::min(boxes[a].x0, boxes[b].x0), std::min(boxes[a].y0, boxes[b].y0),
+					std::max(boxes[a].x1, boxes[b].x1), std::max(boxes[a].y1, boxes[b].y1)};
+				boxes.erase(boxes.begin() + b);
+				isMerged = true;
+			}
+		}
+	}
+	uint64_t added = 0;
+	for (const PatchBox& box : boxes)
+		added += this->addPatch(box, ratio) != nullptr;
+	return added;
+}
+
+template<typename T>
+bool RefinedNodes<T>::isFree(const PatchBox& box) const noexcept(true)
+{
+	for (const auto& patch : this->_patches) {
+		const PatchBox& other = patch->_box;
+		if (!(box.x0 > other.x1 || other.x0 > box.x1 || box.y0 > other.y1 || other.y0 > box.y1))
+			return false;
+	}
+	return true;
+}
+
+template<typename T>
+void RefinedNodes<T>::calculate(const prec_t epsilon)
+{
+	this->_nodes.calculate(epsilon);
+	this->_couplingCnt = 0;
+	this->_hasConverged = true;
+	if (this->_patches.empty())
+		return;
+	while (true) {
+		prec_t change = 0.0f;
+		for (const auto& patch : this->_patches)
+			change = std::max(change, patch->pullBoundary(*this));
+		// patches are always solved against the latest ring, whichever way the loop ends
+		for (const auto& patch : this->_patches)
+			patch->calculate(epsilon);
+		if (this->_couplingCnt > 0 && change < epsilon)
+			break;
+		if (this->_couplingCnt == this->_maxCouplings) {
+			this->_hasConverged = false;
+			break;
+		}
+		++(this->_couplingCnt);
+		for (const auto& patch : this->_patches)
+			patch->pushInterior(*this);
+		this->_nodes.calculate(epsilon);
+	}
+	for (const auto& patch : this->_patches)
+		this->_hasConverged = this->_hasConverged && patch->hasConverged();
+}
+
+template<typename T>
+T RefinedNodes<T>::sample(const prec_t& x, const prec_t& y) const
+{
+	const prec_t clampX = std::min<prec_t>(std::max<prec_t>(x, 0), this->_nodeX - 1);
+	const prec_t clampY = std::min<prec_t>(std::max<prec_t>(y, 0), this->_nodeY - 1);
+	const uint64_t posX = std::min<uint64_t>(static_cast<uint64_t>(clampX), this->_nodeX - 2);
+	const uint64_t posY = std::min<uint64_t>(static_cast<uint64_t>(clampY), this->_nodeY - 2);
+	const prec_t fracX = clampX - posX, fracY = clampY - posY;
+	const prec_t north = (1 - fracX) * this->_nodes.getTemp(posX, posY) + fracX * this->_nodes.getTemp(posX + 1, posY);
+	const prec_t south = (1 - fracX) * this->_nodes.getTemp(posX, posY + 1) +
+		fracX * this->_nodes.getTemp(posX + 1, posY + 1);
+	return static_cast<T>((1 - fracY) * north + fracY * south);
+}
+
+template<typename T>
+prec_t RefinedNodes<T>::pullBoundary(const RefinedNodes<T>& parent)
+{
+	const prec_t step = 1.0f / this->_ratio;
+	// the first time round the parent field is the starting guess inside as well
+	if (!this->_hasGuess) {
+		std::vector<T> guess(this->_nodeX * this->_nodeY);
+		for (uint64_t i = 0; i < this->_nodeY; ++i)
+			for (uint64_t j = 0; j < this->_nodeX; ++j)
+				guess[i * this->_nodeX + j] = parent.sample(this->_box.x0 + j * step, this->_box.y0 + i * step);
+		this->_nodes.setInitialGuess(guess.data());
+		this->_hasGuess = true;
+	}
+	// read the whole ring first, setting a node marks the level unsolved
+	std::vector<std::pair<std::pair<uint64_t, uint64_t>, T>> ring;
+	const auto pull = [&] (const uint64_t& posX, const uint64_t& posY) -> void {
+		if (!this->_isHeatSource[posY * this->_nodeX + posX])
+			ring.push_back(std::make_pair(std::make_pair(posX, posY),
+				parent.sample(this->_box.x0 + posX * step, this->_box.y0 + posY * step)));
+	};
+	for (uint64_t i = 0; i < this->_nodeX; ++i) {
+		pull(i, 0);
+		pull(i, this->_nodeY - 1);
+	}
+	for (uint64_t i = 1; i < this->_nodeY - 1; ++i) {
+		pull(0, i);
+		pull(this->_nodeX - 1, i);
+	}
+	prec_t change = 0.0f;
+	for (const auto& i : ring)
+		change = std::max<prec_t>(change, std::fabs(i.second - this->_nodes.getTemp(i.first.first, i.first.second)));
+	for (const auto& i : ring)
+		this->_nodes.setHeatSource(i.first.first, i.first.second, i.second);
+	return change;
+}
+
+template<typename T>
+void RefinedNodes<T>::pushInterior(RefinedNodes<T>& parent) const
+{
+	// on a side along the parent's wall there is nothing to overlap with
+	const uint64_t x0 = this->_box.x0 == 0 ? 1 : this->_box.x0 + overlap;
+	const uint64_t y0 = this->_box.y0 == 0 ? 1 : this->_box.y0 + overlap;
+	const uint64_t x1 = this->_box.x1 == parent._nodeX - 1 ? parent._nodeX - 2 : this->_box.x1 - overlap;
+	const uint64_t y1 = this->_box.y1 == parent._nodeY - 1 ? parent._nodeY - 2 : this->_box.y1 - overlap;
+	for (uint64_t i = y0; i <= y1 && i <= this->_box.y1; ++i) {
+		for (uint64_t j = x0; j <= x1 && j <= this->_box.x1; ++j) {
+			if (parent._isHeatSource[i * parent._nodeX + j])
+				continue;
+			parent._nodes.setHeatSource(j, i, this->_nodes.getTemp((j - this->_box.x0) * this->_ratio,
+				(i - this->_box.y0) * this->_ratio));
+		}
+	}
+}
+
+template<typename T>
+T RefinedNodes<T>::getTemp(const prec_t& x, const prec_t& y) const
+{
+	for (const auto& patch : this->_patches) {
+		const PatchBox& box = patch->_box;
+		if (x >= box.x0 && x <= box.x1 && y >= box.y0 && y <= box.y1)
+			return patch->getTemp((x - box.x0) * patch->_ratio, (y - box.y0) * patch->_ratio);
+	}
+	return this->sample(x, y);
+}
+
+template<typename T>
+const Nodes<T>& RefinedNodes<T>::getNodes(void) const noexcept(true)
+{
+	return this->_nodes;
+}
+
+template<typename T>
+uint64_t RefinedNodes<T>::getPatchCount(void) const noexcept(true)
+{
+	return this->_patches.size();
+}
+
+template<typename T>
+RefinedNodes<T>& RefinedNodes<T>::getPatch(const uint64_t& patch)
+{
+	return *(this->_patches[patch]);
+}
+
+template<typename T>
+const PatchBox& RefinedNodes<T>::getBox(void) const noexcept(true)
+{
+	return this->_box;
+}
+
+template<typename T>
+unsigned int RefinedNodes<T>::getRatio(void) const noexcept(true)
+{
+	return this->_ratio;
+}
+
+template<typename T>
+uint64_t RefinedNodes<T>::getCellCount(void) const noexcept(true)
+{
+	uint64_t cells = this->_nodeX * this->_nodeY;
+	for (const auto& patch : this->_patches)
+		cells += patch->getCellCount();
+	return cells;
+}
+
+template<typename T>
+uint64_t RefinedNodes<T>::getCouplingCount(void) const noexcept(true)
+{
+	return this->_couplingCnt;
+}
+
+template<typename T>
+bool RefinedNodes<T>::hasConverged(void) const noexcept(true)
+{
+	return this->_hasConverged;
+}
+
+}
+
+#endif
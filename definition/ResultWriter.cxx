@@ -0,0 +1,293 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+#ifndef RESULT_WRITER_CXX
+#define RESULT_WRITER_CXX
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <cstdio>
+#include <cmath>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+
+#include "../header/ResultWriter.h"
+
+namespace HMT
+{
+
+template<typename T>
+inline bool ResultWriter::write(const std::string& path, const ResultFormat format, const uint64_t& nodeX,
+		const uint64_t& nodeY, const T* values, const unsigned int precision)
+{
+	switch (format) {
+	case ResultFormat::Csv:
+		return ResultWriter::writeCsv(path, nodeX, nodeY, values, precision);
+	case ResultFormat::Raw:
+		return ResultWriter::writeRaw(path, nodeX, nodeY, values);
+	case ResultFormat::Vtk:
+		return ResultWriter::writeVtk(path, nodeX, nodeY, values);
+	}
+	return false;
+}
+
+template<typename T>
+inline bool ResultWriter::writeCsv(const std::string& path, const uint64_t& nodeX, const uint64_t& nodeY,
+		const T* values, const unsigned int precision)
+{
+	return ResultWriter::writeRows<T>(path, ResultFormat::Csv, nodeX, nodeY,
+		[values, nodeX] (const uint64_t& row) -> const T* { return values + row * nodeX; }, precision);
+}
+
+template<typename T>
+inline bool ResultWriter::writeRaw(const std::string& path, const uint64_t& nodeX, const uint64_t& nodeY,
+		const T* values)
+{
+	const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0)
+		return false;
+	const bool isWritten = ResultWriter::writeValues(fd, values, nodeX * nodeY);
+	return ::close(fd) == 0 && isWritten;
+}
+
+template<typename T>
+inline bool ResultWriter::writeVtk(const std::string& path, const uint64_t& nodeX, const uint64_t& nodeY,
+		const T* values)
+{
+	const std::string head = ResultWriter::vtkHead<T>(nodeX, nodeY), tail = ResultWriter::vtkTail();
+	// the appended block opens with its byte count as a little-endian UInt64
+	const uint64_t dataSize = nodeX * nodeY * sizeof(Stored<T>);
+	char sizeBytes[8];
+	for (unsigned int i = 0; i < 8; ++i)
+		sizeBytes[i] = static_cast<char>(dataSize >> (8 * i));
+
+	const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0)
+		return false;
+	bool isWritten;
+	if (std::is_same<T, Stored<T>>::value && ResultWriter::isLittleEndian()) {
+		struct iovec parts[4] = {
+			{const_cast<char*>(head.data()), head.size()},
+			{sizeBytes, sizeof(sizeBytes)},
+			{const_cast<T*>(values), dataSize},
+			{const_cast<char*>(tail.data()), tail.size()}
+		};
+		isWritten = ResultWriter::writeAllV(fd, parts, 4);
+	} else {
+		isWritten = ResultWriter::writeAll(fd, head.data(), head.size()) &&
+			ResultWriter::writeAll(fd, sizeBytes, sizeof(sizeBytes)) &&
+			ResultWriter::writeValues(fd, values, nodeX * nodeY) &&
+			ResultWriter::writeAll(fd, tail.data(), tail.size());
+	}
+	return ::close(fd) == 0 && isWritten;
+}
+
+template<typename T, typename RowAt>
+inline bool ResultWriter::writeRows(const std::string& path, const ResultFormat format, const uint64_t& nodeX,
+		const uint64_t& nodeY, RowAt rowAt, const unsigned int precision)
+{
+	const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0)
+		return false;
+	bool isWritten = true;
+	if (format == ResultFormat::Csv) {
+		// room for one more field and its separator past the flush mark
+		const uint64_t flushAt = std::min(static_cast<uint64_t>(bufferSize), nodeX * nodeY * 32);
+		std::vector<char> buffer(flushAt + maxFieldWidth + 1);
+		uint64_t used = 0;
+		for (uint64_t i = 0; isWritten && i < nodeY; ++i) {
+			const T* row = rowAt(i);
+			isWritten = row != nullptr;
+			for (uint64_t j = 0; isWritten && j < nodeX; ++j) {
+				if (j > 0)
+					buffer[used++] = ',';
+				used += ResultWriter::formatFixed(row[j], precision, buffer.data() + used);
+				if (used >= flushAt) {
+					isWritten = ResultWriter::writeAll(fd, buffer.data(), used);
+					used = 0;
+				}
+			}
+			buffer[used++] = '\n';
+		}
+		isWritten = isWritten && ResultWriter::writeAll(fd, buffer.data(), used);
+	} else {
+		// row by row through writeValues, in the same layout write() gives a whole grid
+		const std::string head = ResultWriter::vtkHead<T>(nodeX, nodeY), tail = ResultWriter::vtkTail();
+		const uint64_t dataSize = nodeX * nodeY * sizeof(Stored<T>);
+		char sizeBytes[8];
+		for (unsigned int i = 0; i < 8; ++i)
+			sizeBytes[i] = static_cast<char>(dataSize >> (8 * i));
+		const bool isVtk = format == ResultFormat::Vtk;
+		if (isVtk)
+			isWritten = ResultWriter::writeAll(fd, head.data(), head.size()) &&
+				ResultWriter::writeAll(fd, sizeBytes, sizeof(sizeBytes));
+		for (uint64_t i = 0; isWritten && i < nodeY; ++i) {
+			const T* row = rowAt(i);
+			isWritten = row != nullptr && ResultWriter::writeValues(fd, row, nodeX);
+		}
+		if (isVtk)
+			isWritten = isWritten && ResultWriter::writeAll(fd, tail.data(), tail.size());
+	}
+	return ::close(fd) == 0 && isWritten;
+}
+
+template<typename T>
+inline uint64_t ResultWriter::formatFixed(const T& value, const unsigned int precision, char* out) noexcept(true)
+{
+	static const uint64_t powers[19] = {1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull,
+		10000000ull, 100000000ull, 1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull,
+		10000000000000ull, 100000000000000ull, 1000000000000000ull, 10000000000000000ull,
+		100000000000000000ull, 1000000000000000000ull};
+	const unsigned int digits = std::min(precision, static_cast<unsigned int>(maxPrecision));
+	// float and double widen exactly, and long double keeps 64 bits for the scaled integer
+	const long double scaled = digits > 18 ? 0 : std::fabs(static_cast<long double>(value)) * powers[digits];
+	if (digits > 18 || !std::isfinite(scaled) || scaled >= 1.8e19L) {
+		const int written = std::snprintf(out, maxFieldWidth, "%.*Lf", static_cast<int>(digits),
+			static_cast<long double>(value));
+		return std::min<uint64_t>(std::max(written, 0), maxFieldWidth - 1);
+	}
+
+	// nearbyint rounds ties to even under the default mode, as glibc's printf does
+	const uint64_t scaledInt = static_cast<uint64_t>(std::nearbyint(scaled));
+	char* pos = out;
+	if (std::signbit(value))
+		*pos++ = '-';
+	char whole[20];
+	unsigned int wholeLen = 0;
+	uint64_t rest = scaledInt / powers[digits];
+	do {
+		whole[wholeLen++] = static_cast<char>('0' + rest % 10);
+		rest /= 10;
+	} while (rest > 0);
+	while (wholeLen > 0)
+		*pos++ = whole[--wholeLen];
+	if (digits > 0) {
+		*pos++ = '.';
+		uint64_t fraction = scaledInt % powers[digits];
+		for (unsigned int i = digits; i-- > 0; ) {
+			pos[i] = static_cast<char>('0' + fraction % 10);
+			fraction /= 10;
+		}
+		pos += digits;
+	}
+	return pos - out;
+}
+
+inline bool ResultWriter::isLittleEndian(void) noexcept(true)
+{
+	const uint32_t probe = 0x01020304;
+	return reinterpret_cast<const uint8_t*>(&probe)[0] == 0x04;
+}
+
+template<typename T>
+inline std::string ResultWriter::vtkHead(const uint64_t& nodeX, const uint64_t& nodeY)
+{
+	const std::string extent = "0 " + std::to_string(nodeX - 1) + " 0 " + std::to_string(nodeY - 1) + " 0 0";
+	return std::string("<?xml version=\"1.0\"?>\n") +
+		"<VTKFile type=\"ImageData\" version=\"1.0\" byte_order=\"LittleEndian\" header_type=\"UInt64\">\n" +
+		"  <ImageData WholeExtent=\"" + extent + "\" Origin=\"0 0 0\" Spacing=\"1 1 1\">\n" +
+		"    <Piece Extent=\"" + extent + "\">\n" +
+		"      <PointData Scalars=\"temperature\">\n" +
+		"        <DataArray type=\"" + (sizeof(Stored<T>) == 4 ? "Float32" : "Float64") +
+		"\" Name=\"temperature\" format=\"appended\" offset=\"0\"/>\n" +
+		"      </PointData>\n" +
+		"    </Piece>\n" +
+		"  </ImageData>\n" +
+		"  <AppendedData encoding=\"raw\">\n_";
+}
+
+inline std::string ResultWriter::vtkTail(void)
+{
+	return "\n  </AppendedData>\n</VTKFile>\n";
+}
+
+template<typename T>
+inline void ResultWriter::encode(const T* values, const uint64_t& count, char* buffer) noexcept(true)
+{
+	const bool isSwapped = !ResultWriter::isLittleEndian();
+	for (uint64_t i = 0; i < count; ++i) {
+		const Stored<T> stored = static_cast<Stored<T>>(values[i]);
+		char* bytes = buffer + i * sizeof(stored);
+		std::memcpy(bytes, &stored, sizeof(stored));
+		if (isSwapped)
+			std::reverse(bytes, bytes + sizeof(stored));
+	}
+}
+
+template<typename T>
+inline bool ResultWriter::writeValues(const int fd, const T* values, const uint64_t& count)
+{
+	if (std::is_same<T, Stored<T>>::value && ResultWriter::isLittleEndian())
+		return ResultWriter::writeAll(fd, values, count * sizeof(T));
+	std::vector<char> buffer(bufferSize);
+	const uint64_t chunk = bufferSize / sizeof(Stored<T>);
+	for (uint64_t i = 0; i < count; i += chunk) {
+		const uint64_t n = std::min(chunk, count - i);
+		ResultWriter::encode(values + i, n, buffer.data());
+		if (!ResultWriter::writeAll(fd, buffer.data(), n * sizeof(Stored<T>)))
+			return false;
+	}
+	return true;
+}
+
+inline bool ResultWriter::writeAll(const int fd, const void* data, uint64_t size)
+{
+	const char* bytes = static_cast<const char*>(data);
+	while (size > 0) {
+		const ssize_t written = ::write(fd, bytes, size);
+		if (written <= 0)
+			return false;
+		bytes += written;
+		size -= written;
+	}
+	return true;
+}
+
+inline bool ResultWriter::writeAllV(const int fd, struct iovec* parts, int partCnt)
+{
+	while (partCnt > 0) {
+		ssize_t written = ::writev(fd, parts, partCnt);
+		if (written <= 0)
+			return false;
+		// drop what went out, the first part left may be cut short
+		while (partCnt > 0 && static_cast<uint64_t>(written) >= parts->iov_len) {
+			written -= parts->iov_len;
+			++parts;
+			--partCnt;
+		}
+		if (partCnt > 0) {
+			parts->iov_base = static_cast<char*>(parts->iov_base) + written;
+			parts->iov_len -= written;
+		}
+	}
+	return true;
+}
+
+}
+
+#endif
@@ -0,0 +1,127 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+
+#ifndef SOLVE_CONTROL_CXX
+#define SOLVE_CONTROL_CXX
+
+#include <new>
+#include <limits>
+#include <sys/mman.h>
+
+#include "../header/SolveControl.h"
+
+namespace HMT
+{
+
+inline SolveControl::SolveControl(void): _shared(nullptr), _isMapped(false)
+{
+	void* page = ::mmap(nullptr, sizeof(Shared), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	// without the shared page a cancel just does not reach Distributed ranks
+	this->_isMapped = page != MAP_FAILED;
+	this->_shared = this->_isMapped ? new (page) Shared : new Shared;
+	this->_shared->status = static_cast<int>(SolveStatus::Queued);
+	this->_shared->isCancelled = false;
+	this->_shared->deadline = std::numeric_limits<int64_t>::max();
+	this->_shared->itterCnt = 0;
+	this->_shared->residual = -1;
+}
+
+inline SolveControl::~SolveControl(void)
+{
+	if (this->_isMapped) {
+		this->_shared->~Shared();
+		::munmap(this->_shared, sizeof(Shared));
+	} else {
+		delete this->_shared;
+	}
+}
+
+inline void SolveControl::cancel(void) noexcept(true)
+{
+	this->_shared->isCancelled = true;
+}
+
+inline bool SolveControl::isCancelled(void) const noexcept(true)
+{
+	return this->_shared->isCancelled;
+}
+
+inline void SolveControl::setDeadline(const clock::time_point& deadline) noexcept(true)
+{
+	this->_shared->deadline = deadline == clock::time_point::max() ? std::numeric_limits<int64_t>::max() :
+		static_cast<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count());
+}
+
+inline SolveControl::clock::time_point SolveControl::getDeadline(void) const noexcept(true)
+{
+	const int64_t deadline = this->_shared->deadline;
+	if (deadline == std::numeric_limits<int64_t>::max())
+		return clock::time_point::max();
+	return clock::time_point(std::chrono::duration_cast<clock::duration>(std::chrono::nanoseconds(deadline)));
+}
+
+inline void SolveControl::setStatus(const SolveStatus status) noexcept(true)
+{
+	this->_shared->status = static_cast<int>(status);
+}
+
+inline SolveStatus SolveControl::getStatus(void) const noexcept(true)
+{
+	return static_cast<SolveStatus>(this->_shared->status.load());
+}
+
+inline SolveProgress SolveControl::getProgress(void) const noexcept(true)
+{
+	return SolveProgress{this->getStatus(), this->_shared->itterCnt, this->_shared->residual};
+}
+
+inline bool SolveControl::isStopped(void) const noexcept(true)
+{
+	const SolveStatus status = this->getStatus();
+	return status == SolveStatus::Cancelled || status == SolveStatus::DeadlineExceeded;
+}
+
+inline bool SolveControl::poll(const uint64_t& itterCnt, const prec_t& residual) noexcept(true)
+{
+	this->_shared->itterCnt.store(itterCnt, std::memory_order_relaxed);
+	this->_shared->residual.store(static_cast<double>(residual), std::memory_order_relaxed);
+	if (this->isStopped())
+		return true;
+	if (this->_shared->isCancelled) {
+		this->setStatus(SolveStatus::Cancelled);
+		return true;
+	}
+	const int64_t deadline = this->_shared->deadline;
+	if (deadline != std::numeric_limits<int64_t>::max() && deadline <= std::chrono::duration_cast<std::chrono::nanoseconds>(
+			clock::now().time_since_epoch()).count()) {
+		this->setStatus(SolveStatus::DeadlineExceeded);
+		return true;
+	}
+	return false;
+}
+
+}
+
+#endif
@@ -0,0 +1,142 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+#ifndef TELEMETRY_CXX
+#define TELEMETRY_CXX
+
+#include <vector>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <cstdint>
+
+#include "../header/Telemetry.h"
+
+namespace HMT
+{
+
+inline SweepRing::SweepRing(const uint64_t& capacity): _head(0), _tail(0), _dropCnt(0)
+{
+	uint64_t size = 1;
+	while (size < capacity)
+		size <<= 1;
+	this->_slots.resize(size);
+	this->_mask = size - 1;
+}
+
+inline bool SweepRing::push(const SweepRecord& record) noexcept(true)
+{
+	const uint64_t head = this->_head.load(std::memory_order_relaxed);
+	if (head - this->_tail.load(std::memory_order_acquire) > this->_mask) {
+		this->_dropCnt.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+	this->_slots[head & this->_mask] = record;
+	this->_head.store(head + 1, std::memory_order_release);
+	return true;
+}
+
+inline bool SweepRing::pop(SweepRecord& record) noexcept(true)
+{
+	const uint64_t tail = this->_tail.load(std::memory_order_relaxed);
+	if (tail == this->_head.load(std::memory_order_acquire))
+		return false;
+	record = this->_slots[tail & this->_mask];
+	this->_tail.store(tail + 1, std::memory_order_release);
+	return true;
+}
+
+inline uint64_t SweepRing::capacity(void) const noexcept(true)
+{
+	return this->_slots.size();
+}
+
+inline uint64_t SweepRing::dropCount(void) const noexcept(true)
+{
+	return this->_dropCnt.load(std::memory_order_relaxed);
+}
+
+inline Telemetry::Telemetry(const uint64_t& ringCapacity): _isCounting(false),
+	_sweepCnt(0), _cellCnt(0), _byteCnt(0)
+{
+	if (ringCapacity > 0)
+		this->_ring.reset(new SweepRing(ringCapacity));
+}
+
+inline void Telemetry::setObserver(const std::function<void(const SweepRecord&)>& observer)
+{
+	this->_observer = observer;
+}
+
+inline void Telemetry::setCounting(const bool choice) noexcept(true)
+{
+	this->_isCounting.store(choice, std::memory_order_relaxed);
+}
+
+inline bool Telemetry::isCounting(void) const noexcept(true)
+{
+	return this->_isCounting.load(std::memory_order_relaxed);
+}
+
+inline bool Telemetry::pop(SweepRecord& record) noexcept(true)
+{
+	return this->_ring && this->_ring->pop(record);
+}
+
+inline uint64_t Telemetry::dropCount(void) const noexcept(true)
+{
+	return this->_ring ? this->_ring->dropCount() : 0;
+}
+
+inline uint64_t Telemetry::getSweepCount(void) const noexcept(true)
+{
+	return this->_sweepCnt.load(std::memory_order_relaxed);
+}
+
+inline uint64_t Telemetry::getCellsUpdated(void) const noexcept(true)
+{
+	return this->_cellCnt.load(std::memory_order_relaxed);
+}
+
+inline uint64_t Telemetry::getBytesMoved(void) const noexcept(true)
+{
+	return this->_byteCnt.load(std::memory_order_relaxed);
+}
+
+inline void Telemetry::publish(const SweepRecord& record)
+{
+	if (record.cellsUpdated > 0 || record.bytesMoved > 0) {
+		this->_sweepCnt.fetch_add(1, std::memory_order_relaxed);
+		this->_cellCnt.fetch_add(record.cellsUpdated, std::memory_order_relaxed);
+		this->_byteCnt.fetch_add(record.bytesMoved, std::memory_order_relaxed);
+	}
+	if (this->_ring)
+		this->_ring->push(record);
+	if (this->_observer)
+		this->_observer(record);
+}
+
+}
+
+#endif
@@ -0,0 +1,130 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+#ifndef THREAD_POOL_CXX
+#define THREAD_POOL_CXX
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+#include "../header/ThreadPool.h"
+
+namespace HMT
+{
+
+inline Barrier::Barrier(const unsigned int count): _count(count), _waiting(0), _generation(0)
+{ }
+
+inline void Barrier::wait(void)
+{
+	std::unique_lock<std::mutex> lock(this->_mutex);
+	const uint64_t generation = this->_generation;
+	if (++(this->_waiting) == this->_count) {
+		this->_waiting = 0;
+		++(this->_generation);
+		this->_cond.notify_all();
+	} else {
+		this->_cond.wait(lock, [&] { return generation != this->_generation; });
+	}
+}
+
+inline unsigned int Barrier::size(void) const noexcept(true)
+{
+	return this->_count;
+}
+
+inline ThreadPool::ThreadPool(const unsigned int threadCnt): _generation(0), _pending(0), _stop(false),
+	_barrier(threadCnt > 0 ? threadCnt : 1)
+{
+	for (unsigned int i = 1; i < this->_barrier.size(); ++i)
+		this->_workers.push_back(std::thread(&ThreadPool::workerLoop, this, i));
+}
+
+inline ThreadPool::~ThreadPool(void)
+{
+	{
+		std::lock_guard<std::mutex> guard(this->_mutex);
+		this->_stop = true;
+	}
+	this->_wake.notify_all();
+	for (auto& i : this->_workers)
+		i.join();
+}
+
+inline unsigned int ThreadPool::size(void) const noexcept(true)
+{
+	return this->_barrier.size();
+}
+
+inline Barrier& ThreadPool::barrier(void) noexcept(true)
+{
+	return this->_barrier;
+}
+
+inline void ThreadPool::run(const std::function<void(unsigned int)>& task)
+{
+	std::lock_guard<std::mutex> runGuard(this->_runMutex);
+	{
+		std::lock_guard<std::mutex> guard(this->_mutex);
+		this->_task = task;
+		this->_pending = static_cast<unsigned int>(this->_workers.size());
+		++(this->_generation);
+	}
+	this->_wake.notify_all();
+
+	task(0);
+
+	std::unique_lock<std::mutex> lock(this->_mutex);
+	this->_done.wait(lock, [&] { return this->_pending == 0; });
+	this->_task = nullptr;
+}
+
+inline void ThreadPool::workerLoop(const unsigned int threadId)
+{
+	uint64_t seen = 0;
+	while (true) {
+		std::function<void(unsigned int)> task;
+		{
+			std::unique_lock<std::mutex> lock(this->_mutex);
+			this->_wake.wait(lock, [&] { return this->_stop || this->_generation != seen; });
+			if (this->_stop)
+				return;
+			seen = this->_generation;
+			task = this->_task;
+		}
+		task(threadId);
+		{
+			std::lock_guard<std::mutex> guard(this->_mutex);
+			if (--(this->_pending) == 0)
+				this->_done.notify_one();
+		}
+	}
+}
+
+}
+
+#endif
@@ -0,0 +1,145 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+
+#ifndef TILE_STORE_CXX
+#define TILE_STORE_CXX
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "../header/TileStore.h"
+
+namespace HMT
+{
+
+inline TileStore::TileStore(const std::string& path): _fd(-1), _path(path),
+	_stats{0, 0, std::chrono::nanoseconds(0), std::chrono::nanoseconds(0), std::chrono::nanoseconds(0),
+		0, std::chrono::nanoseconds(0)}
+{
+	if (this->_path.empty()) {
+		const char* dir = std::getenv("TMPDIR");
+		std::string pattern = std::string(dir && *dir ? dir : "/tmp") + "/hmt-store-XXXXXX";
+		std::vector<char> name(pattern.begin(), pattern.end());
+		name.push_back('\0');
+		this->_fd = ::mkstemp(name.data());
+		if (this->_fd >= 0)
+			::unlink(name.data());
+	} else {
+		this->_fd = ::open(this->_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	}
+	if (this->_fd < 0) {
+		std::clog << "TileStore: cannot create " << (this->_path.empty() ? "a temporary file" : this->_path)
+			<< ": " << std::strerror(errno) << std::endl;
+		return;
+	}
+	// bands are read front to back, let the kernel read ahead further than usual
+	::posix_fadvise(this->_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+}
+
+inline TileStore::~TileStore(void)
+{
+	if (this->_fd < 0)
+		return;
+	::close(this->_fd);
+	if (!this->_path.empty())
+		::unlink(this->_path.c_str());
+}
+
+inline bool TileStore::isValid(void) const noexcept(true)
+{
+	return this->_fd >= 0;
+}
+
+inline bool TileStore::reserve(const uint64_t& bytes)
+{
+	if (this->_fd < 0)
+		return false;
+	if (::ftruncate(this->_fd, bytes) != 0) {
+		std::clog << "TileStore: cannot size the store to " << bytes << " bytes: " << std::strerror(errno) << std::endl;
+		return false;
+	}
+	return true;
+}
+
+inline bool TileStore::read(const uint64_t& offset, void* data, uint64_t bytes)
+{
+	const auto start = std::chrono::steady_clock::now();
+	char* out = static_cast<char*>(data);
+	uint64_t at = offset;
+	this->_stats.bytesRead += bytes;
+	while (bytes > 0) {
+		const ssize_t done = ::pread(this->_fd, out, bytes, at);
+		if (done < 0 && errno == EINTR)
+			continue;
+		if (done <= 0) {
+			std::clog << "TileStore: read at " << at << " failed: " << (done < 0 ? std::strerror(errno) : "end of file")
+				<< std::endl;
+			return false;
+		}
+		out += done;
+		at += done;
+		bytes -= done;
+	}
+	this->_stats.readTime += std::chrono::steady_clock::now() - start;
+	return true;
+}
+
+inline bool TileStore::write(const uint64_t& offset, const void* data, uint64_t bytes)
+{
+	const auto start = std::chrono::steady_clock::now();
+	const char* in = static_cast<const char*>(data);
+	uint64_t at = offset;
+	this->_stats.bytesWritten += bytes;
+	while (bytes > 0) {
+		const ssize_t done = ::pwrite(this->_fd, in, bytes, at);
+		if (done < 0 && errno == EINTR)
+			continue;
+		if (done <= 0) {
+			std::clog << "TileStore: write at " << at << " failed: " << (done < 0 ? std::strerror(errno) : "nothing written")
+				<< std::endl;
+			return false;
+		}
+		in += done;
+		at += done;
+		bytes -= done;
+	}
+	this->_stats.writeTime += std::chrono::steady_clock::now() - start;
+	return true;
+}
+
+inline StreamStats TileStore::getStats(void) const noexcept(true)
+{
+	return this->_stats;
+}
+
+}
+
+#endif
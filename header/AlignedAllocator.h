@@ -0,0 +1,67 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+#ifndef ALIGNED_ALLOCATOR_H
+#define ALIGNED_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace HMT
+{
+
+/**
+*	allocator handing out cache-line aligned blocks so grid rows start on a
+*	boundary the vector units can load from without splitting lines; grid
+*	sized blocks come straight from GridMemory and follow its huge page policy
+**/
+template<typename T, std::size_t Align = 64>
+class AlignedAllocator
+{
+	static_assert(Align <= 4096, "mapped blocks are only page aligned");
+
+public:
+	using value_type = T;
+	template<typename U> struct rebind { using other = AlignedAllocator<U, Align>; };
+
+	AlignedAllocator(void) noexcept(true) = default;
+	template<typename U> AlignedAllocator(const AlignedAllocator<U, Align>&) noexcept(true) { }
+
+	T* allocate(std::size_t n);
+	void deallocate(T* ptr, std::size_t n) noexcept(true);
+};
+
+template<typename T, typename U, std::size_t Align>
+bool operator==(const AlignedAllocator<T, Align>&, const AlignedAllocator<U, Align>&) noexcept(true);
+template<typename T, typename U, std::size_t Align>
+bool operator!=(const AlignedAllocator<T, Align>&, const AlignedAllocator<U, Align>&) noexcept(true);
+
+template<typename T> using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+}
+
+#include "../definition/AlignedAllocator.cxx"
+
+#endif
@@ -0,0 +1,132 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+
+#ifndef ASYNC_SOLVER_H
+#define ASYNC_SOLVER_H
+
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <chrono>
+
+#include "Nodes.h"
+#include "SolveControl.h"
+
+namespace HMT
+{
+
+template<typename T> class AsyncSolver;
+
+/**
+*	one submitted solve: progress while it runs, cancel() at any time, and
+*	the plate once it is done; copies share the same solve
+**/
+template<typename T>
+class SolveHandle
+{
+public:
+	SolveHandle(void) = default;
+
+	bool isValid(void) const noexcept(true);
+	SolveProgress getProgress(void) const noexcept(true);
+	// a queued solve still runs one iteration, so its grid is never left unsolved
+	void cancel(void) const noexcept(true);
+	bool isReady(void) const;
+	void wait(void) const;
+	// false if the solve is still running after timeout
+	template<typename Rep, typename Period>
+	bool waitFor(const std::chrono::duration<Rep, Period>& timeout) const;
+	// blocks until done and rethrows what the solve threw; a stopped solve hands
+	// back its best so far with hasConverged() false, getProgress() says why
+	const Nodes<T>& get(void) const;
+
+private:
+	friend class AsyncSolver<T>;
+	SolveHandle(const std::shared_ptr<Nodes<T>>& nodes, const std::shared_ptr<SolveControl>& control,
+		const std::shared_future<void>& done);
+
+	std::shared_ptr<Nodes<T>> _nodes;
+	std::shared_ptr<SolveControl> _control;
+	std::shared_future<void> _done;
+};
+
+/**
+*	fixed set of threads solving submitted plates in order of submission;
+*	each solve runs on a detached copy (Nodes::detachShared), the caller's
+*	Nodes is free again right away; its telemetry and checkpointing stay with it
+**/
+template<typename T>
+class AsyncSolver
+{
+public:
+	typedef SolveControl::clock clock;
+
+	// 0 picks std::thread::hardware_concurrency()
+	explicit AsyncSolver(const unsigned int workerCnt);
+	AsyncSolver(const AsyncSolver&) = delete;
+	AsyncSolver& operator=(const AsyncSolver&) = delete;
+	// cancels whatever is still queued or running and waits for it
+	virtual ~AsyncSolver(void);
+
+	// the deadline stops the solve wherever it is then, queued time counts;
+	// telemetry, if any, is this submission's own and traces only its sweeps
+	SolveHandle<T> submit(const Nodes<T>& nodes, const prec_t epsilon,
+		const clock::time_point& deadline = clock::time_point::max(),
+		const std::shared_ptr<Telemetry>& telemetry = nullptr);
+	unsigned int size(void) const noexcept(true);
+	// queued, not yet picked up by a worker
+	uint64_t pending(void);
+	// one per hardware thread, for callers that do not keep their own
+	static AsyncSolver<T>& shared(void);
+
+protected:
+	void workerLoop(void);
+
+private:
+	struct Job
+	{
+		std::shared_ptr<Nodes<T>> nodes;
+		std::shared_ptr<SolveControl> control;
+		prec_t epsilon;
+		std::promise<void> done;
+	};
+
+	std::vector<std::thread> _workers;
+	std::mutex _mutex;
+	std::condition_variable _wake;
+	std::deque<Job> _queue;
+	std::vector<std::shared_ptr<SolveControl>> _running;
+	bool _stop;
+};
+
+}
+
+#include "../definition/AsyncSolver.cxx"
+
+#endif
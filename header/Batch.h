@@ -0,0 +1,161 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <utility>
+#include <cstdint>
+#include <string>
+
+#include "Precision.h"
+#include "AlignedAllocator.h"
+#include "Kernels.h"
+#include "ThreadPool.h"
+#include "ResultWriter.h"
+
+namespace HMT
+{
+
+/**
+*	one plate of a batch: every scenario has the batch's size, they differ
+*	in wall temperatures and heat sources only
+**/
+template<typename T>
+struct Scenario
+{
+	T tempNorth, tempEast, tempSouth, tempWest;
+	std::vector<std::pair<std::pair<uint64_t, uint64_t>, T>> heatSources;
+};
+
+/**
+*	scenario lanes of the interleaved layout: node k of lane l sits at
+*	k * width + l, so one vector holds the same node of width scenarios;
+*	a width of 1 means T has no vector type and is never interleaved
+**/
+template<typename T>
+struct Lanes
+{
+	static const unsigned int width = 1;
+	typedef T vec;
+	typedef int64_t mask;
+	typedef int64_t maskLane;
+};
+
+template<>
+struct Lanes<double>
+{
+	static const unsigned int width = 4;
+	typedef double vec __attribute__((vector_size(32)));
+	typedef int64_t mask __attribute__((vector_size(32)));
+	typedef int64_t maskLane;
+};
+
+template<>
+struct Lanes<float>
+{
+	static const unsigned int width = 8;
+	typedef float vec __attribute__((vector_size(32)));
+	typedef int32_t mask __attribute__((vector_size(32)));
+	typedef int32_t maskLane;
+};
+
+/**
+*	solves many same-sized plates with Jacobi, each result bit for bit what
+*	a serial Nodes<T> gives; scenarios (or interleaved packs of them) are
+*	spread over the workers in ranges the idle ones steal from
+**/
+template<typename T>
+class BatchSolver
+{
+public:
+	BatchSolver(const uint64_t& nodeX, const uint64_t& nodeY);
+	virtual ~BatchSolver() = default;
+
+	// 0 uses every hardware thread
+	void setThreadCount(const unsigned int threadCnt) noexcept(true);
+	unsigned int getThreadCount(void) const noexcept(true);
+	// run Lanes<T>::width scenarios per sweep when they all share heat source positions
+	void setInterleaved(const bool choice) noexcept(true);
+	bool getInterleaved(void) const noexcept(true);
+	void solve(const std::vector<Scenario<T>>& scenarios, const prec_t epsilon);
+
+	uint64_t size(void) const noexcept(true);
+	// scenario s occupies [s * nodeX * nodeY, (s + 1) * nodeX * nodeY) of getResults()
+	const AlignedVector<T>& getResults(void) const noexcept(true);
+	const T* getResult(const uint64_t& scenario) const noexcept(true);
+	// 0 before solve() and for a scenario or node outside the last one
+	T getTemp(const uint64_t& scenario, const uint64_t& posX, const uint64_t& posY) const;
+	// 0 before solve() and for a scenario outside the last one
+	uint64_t getItterCount(const uint64_t& scenario) const;
+	// exports one scenario's plate; precision is the CSV digits after the point
+	bool writeResult(const uint64_t& scenario, const std::string& path, const ResultFormat format,
+		const unsigned int precision) const;
+	// scenarios solved per sweep in the last solve, 1 unless it was interleaved
+	unsigned int getLaneCount(void) const noexcept(true);
+	// work items the last solve moved between workers
+	uint64_t getStealCount(void) const noexcept(true);
+	// 0ns before solve()
+	std::chrono::nanoseconds getDuration(void) const;
+
+protected:
+	uint64_t index(const uint64_t& posX, const uint64_t& posY) const noexcept(true);
+	bool hasSharedLayout(const std::vector<Scenario<T>>& scenarios) const;
+	void initGrid(const Scenario<T>& scenario, T* grid, uint8_t* isFixed) const;
+	// Jacobi on the grid initGrid left in result, using scratch as the second generation
+	uint64_t solveOne(const uint8_t* isFixed, T* result, T* scratch, const prec_t& epsilon) const;
+	typedef typename Lanes<T>::vec vec;
+	typedef typename Lanes<T>::mask mask;
+	// one interleaved sweep, frozen lanes copied through; leaves each lane's max change in diff
+	void sweepPack(const uint8_t* isFixed, const vec* src, vec* dst, const mask& frozen, vec& diff) const noexcept(true);
+	void sweepPackDefault(const uint8_t* isFixed, const vec* src, vec* dst, const mask& frozen, vec& diff) const noexcept(true);
+	void sweepPackAvx2(const uint8_t* isFixed, const vec* src, vec* dst, const mask& frozen, vec& diff) const noexcept(true);
+	// Jacobi on the Lanes<T>::width scenarios from first on, interleaved in src and dst
+	void solvePack(const std::vector<Scenario<T>>& scenarios, const uint64_t& first,
+		const uint8_t* isFixed, T* src, T* dst, T* grid, const prec_t& epsilon);
+	// a work range keeps its front in the low and its back in the high 32 bits;
+	// the owner takes from the front, thieves from the back
+	static bool takeFront(std::atomic<uint64_t>& range, uint64_t& item) noexcept(true);
+	static bool stealBack(std::atomic<uint64_t>& range, uint64_t& item) noexcept(true);
+
+private:
+	uint64_t _nodeX, _nodeY;
+	unsigned int _threadCnt, _laneCnt;
+	bool _interleaved, _hasSolved;
+	AlignedVector<T> _results;
+	std::vector<uint64_t> _itterCnts;
+	uint64_t _stealCnt;
+	std::shared_ptr<ThreadPool> _threadPool;
+	std::chrono::high_resolution_clock::time_point _startTime, _endTime;
+};
+
+}
+
+#include "../definition/Batch.cxx"
+
+#endif
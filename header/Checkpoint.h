@@ -0,0 +1,95 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <string>
+#include <cstdint>
+
+#include "Precision.h"
+
+namespace HMT
+{
+
+/**
+*	fixed-size head of a checkpoint file; the grid values and the fixed-node
+*	mask follow at 64-byte aligned offsets, both row-major exactly as Nodes
+*	keeps them in memory, so loading is a mapping plus one copy, no parsing
+**/
+struct CheckpointHeader
+{
+	char magic[8];
+	uint32_t version;
+	// 0x01020304 as the writing host stores it, a mismatch means another byte order
+	uint32_t byteOrder;
+	// sizeof(T) and std::numeric_limits<T>::digits, together they name the type
+	uint32_t valueSize;
+	uint32_t valueDigits;
+	uint64_t nodeX, nodeY;
+	uint64_t itterCnt;
+	double residual;
+	uint64_t valueOffset, maskOffset;
+};
+
+/**
+*	read-only mapping of a checkpoint file, the pointers it hands out stay
+*	valid for as long as the object lives
+**/
+class CheckpointFile
+{
+public:
+	static const uint32_t version = 1;
+
+	explicit CheckpointFile(const std::string& path);
+	CheckpointFile(const CheckpointFile&) = delete;
+	CheckpointFile& operator=(const CheckpointFile&) = delete;
+	virtual ~CheckpointFile(void);
+
+	bool isValid(void) const noexcept(true);
+	const CheckpointHeader& header(void) const noexcept(true);
+	template<typename T> bool holds(void) const noexcept(true);
+	template<typename T> const T* values(void) const noexcept(true);
+	const uint8_t* mask(void) const noexcept(true);
+
+	// writes next to path and renames over it, so a job killed mid-write
+	// leaves the previous checkpoint intact
+	template<typename T>
+	static bool write(const std::string& path, const uint64_t& nodeX, const uint64_t& nodeY,
+		const uint64_t& itterCnt, const prec_t& residual, const T* values, const uint8_t* mask);
+
+protected:
+	static bool writeAll(const int fd, const void* data, uint64_t size);
+
+private:
+	const char* _map;
+	uint64_t _size;
+	bool _isValid;
+};
+
+}
+
+#include "../definition/Checkpoint.cxx"
+
+#endif
@@ -0,0 +1,85 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+#ifndef CONJUGATE_GRADIENT_H
+#define CONJUGATE_GRADIENT_H
+
+#include <vector>
+#include <cstdint>
+
+#include "Precision.h"
+#include "SolveControl.h"
+
+namespace HMT
+{
+
+enum class Preconditioner
+{
+	None,
+	Jacobi,		// diagonal scaling
+	SSOR		// symmetric successive over-relaxation, one forward and one backward sweep
+};
+
+/**
+*	matrix-free preconditioned conjugate gradient on the 5-point Laplacian
+*
+*	the unknowns are the free interior nodes; walls and nodes flagged in
+*	isFixed are eliminated as Dirichlet data and only enter the right hand side
+**/
+template<typename T>
+class ConjugateGradient
+{
+public:
+	ConjugateGradient(const uint64_t& nodeX, const uint64_t& nodeY, const uint8_t* isFixed);
+	virtual ~ConjugateGradient(void) = default;
+
+	void setPreconditioner(const Preconditioner preconditioner, const prec_t& omega) noexcept(true);
+	// polled after every iteration, nullptr for none; solve() returns early once it says stop
+	void setSolveControl(SolveControl* control) noexcept(true);
+	// iterates until ||b - A u||_2 / 4, the l2 norm of the update a Jacobi sweep
+	// would make, is below epsilon; returns the number of CG iterations
+	uint64_t solve(T* grid, const prec_t& epsilon);
+	// one entry per iteration, the recurrence residual in the same norm as epsilon
+	const std::vector<prec_t>& getResidualHistory(void) const noexcept(true);
+
+protected:
+	void applyOperator(const T* p, T* out) const;
+	prec_t trueResidual(const T* grid, T* r) const;
+	void precondition(const T* r, T* z) const;
+	prec_t dot(const T* a, const T* b) const;
+
+private:
+	uint64_t _nodeX, _nodeY;
+	std::vector<uint8_t> _isFixed;
+	Preconditioner _preconditioner;
+	prec_t _omega;
+	std::vector<prec_t> _residualHistory;
+	SolveControl* _control;
+};
+
+}
+
+#include "../definition/ConjugateGradient.cxx"
+
+#endif
@@ -0,0 +1,84 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+#ifndef CONVERGENCE_H
+#define CONVERGENCE_H
+
+#include <chrono>
+#include <cstdint>
+
+#include "Precision.h"
+
+namespace HMT
+{
+
+enum class Norm
+{
+	LInf,		// largest change of one sweep
+	L2,			// root of the summed squared changes
+	Relative	// L2 divided by the L2 of the first checked sweep
+};
+
+/**
+*	when and how a Jacobi solve decides it is done; the defaults are the
+*	classic check, L-infinity of every sweep with no budget
+**/
+struct ConvergencePolicy
+{
+	Norm norm = Norm::LInf;
+	// sweeps in between run the update kernel only
+	unsigned int checkEvery = 1;
+	// 0 for no limit, otherwise the solve stops unconverged at this count
+	uint64_t maxItterations = 0;
+	// 0 for no limit, looked at on checked sweeps only
+	std::chrono::nanoseconds timeBudget = std::chrono::nanoseconds(0);
+};
+
+/**
+*	applies a ConvergencePolicy to the norms a solve feeds it
+**/
+class ConvergenceCheck
+{
+public:
+	ConvergenceCheck(const ConvergencePolicy& policy, const prec_t& epsilon);
+
+	// true if sweep number itterCnt (counting from 1) has to measure its change
+	bool isCheckSweep(const uint64_t& itterCnt) const noexcept(true);
+	// turns a measured max |change| or sum of squared changes into the policy norm
+	prec_t norm(const prec_t& measured) noexcept(true);
+	bool isConverged(const prec_t& norm) const noexcept(true);
+	bool isOutOfBudget(const uint64_t& itterCnt) const noexcept(true);
+	Norm getNorm(void) const noexcept(true);
+
+private:
+	ConvergencePolicy _policy;
+	prec_t _epsilon, _reference;
+	std::chrono::high_resolution_clock::time_point _startTime;
+};
+
+}
+
+#include "../definition/Convergence.cxx"
+
+#endif
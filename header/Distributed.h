@@ -0,0 +1,147 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+
+#ifndef DISTRIBUTED_H
+#define DISTRIBUTED_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <chrono>
+
+#include "Precision.h"
+
+namespace HMT
+{
+
+/**
+*	what a rank hands back with its band once it stops sweeping; every
+*	rank reaches the same verdict, the root keeps rank 0's
+**/
+struct RankResult
+{
+	uint64_t itterCnt;
+	prec_t norm;
+	bool hasConverged;
+};
+
+/**
+*	one rank's end of a row-band decomposition: rank r owns a contiguous
+*	band of interior rows and keeps a ghost row above and below it
+*
+*	shaped after the MPI calls a cluster backend would make, so the solver
+*	loop does not change when one is dropped in: exchange() is an
+*	MPI_Sendrecv with each neighbour plus an MPI_Allreduce (MAX or SUM) and
+*	an MPI_Bcast of rank 0's budget verdict, gather() an MPI_Gatherv to
+*	the root; a false return means a peer is gone and the rank should stop
+**/
+class HaloExchange
+{
+public:
+	virtual ~HaloExchange() = default;
+
+	virtual unsigned int rank(void) const noexcept(true) = 0;
+	virtual unsigned int size(void) const noexcept(true) = 0;
+	// sends firstRow up and lastRow down, receives the neighbours' rows into
+	// ghostAbove and ghostBelow (rank 0 and the last rank skip their wall side),
+	// and replaces residual by its MAX, or SUM if isSum, over every rank
+	virtual bool exchange(const void* firstRow, const void* lastRow, void* ghostAbove, void* ghostBelow,
+		prec_t& residual, const bool isSum, bool& isOutOfBudget) = 0;
+	// bytes of the band starting offset bytes into the root's grid
+	virtual bool gather(const void* band, const uint64_t& offset, const uint64_t& bytes,
+		const RankResult& result) = 0;
+};
+
+/**
+*	HaloExchange between processes forked on one host: a POSIX shared
+*	memory segment holds two generations of halo rows and residual slots,
+*	one set per sweep parity, and a futex barrier in the same segment
+*	orders them, so one barrier per sweep is all the synchronisation
+*
+*	built by the parent before it forks; each child picks its rank with
+*	setRank() and works on its inherited mapping, the parent reads the
+*	gathered grid back once every child has exited
+**/
+class ShmHaloExchange: public HaloExchange
+{
+public:
+	// a barrier waiter gives up after this long without the generation moving
+	static const int64_t timeoutMs = 60000;
+
+	ShmHaloExchange(const unsigned int nofRanks, const uint64_t& rowBytes, const uint64_t& gridBytes);
+	ShmHaloExchange(const ShmHaloExchange&) = delete;
+	ShmHaloExchange& operator=(const ShmHaloExchange&) = delete;
+	virtual ~ShmHaloExchange();
+
+	// false if the segment could not be created or mapped
+	bool isOpen(void) const noexcept(true);
+	void setRank(const unsigned int rank) noexcept(true);
+	// wakes every rank blocked in the barrier and makes it return false
+	void abort(void) noexcept(true);
+
+	virtual unsigned int rank(void) const noexcept(true) override;
+	virtual unsigned int size(void) const noexcept(true) override;
+	virtual bool exchange(const void* firstRow, const void* lastRow, void* ghostAbove, void* ghostBelow,
+		prec_t& residual, const bool isSum, bool& isOutOfBudget) override;
+	virtual bool gather(const void* band, const uint64_t& offset, const uint64_t& bytes,
+		const RankResult& result) override;
+
+	// root side, valid once every rank has gathered
+	const void* grid(void) const noexcept(true);
+	RankResult result(void) const noexcept(true);
+	uint64_t segmentBytes(void) const noexcept(true);
+
+protected:
+	struct Header
+	{
+		std::atomic<uint32_t> arrived, generation, isAborted;
+		uint32_t nofRanks;
+		RankResult result;
+	};
+	struct Slot
+	{
+		prec_t residual;
+		bool isOutOfBudget;
+	};
+
+	bool barrier(void) noexcept(true);
+	Slot& slot(const unsigned int parity, const unsigned int rank) const noexcept(true);
+	// 0 is the first owned row, 1 the last
+	char* halo(const unsigned int parity, const unsigned int rank, const unsigned int side) const noexcept(true);
+
+private:
+	void* _segment;
+	size_t _segmentBytes;
+	unsigned int _rank, _nofRanks;
+	uint64_t _rowBytes, _rowStride, _slotOffset, _haloOffset, _gridOffset;
+	// sweeps this rank has exchanged, picks the parity
+	uint64_t _exchangeCnt;
+};
+
+}
+
+#include "../definition/Distributed.cxx"
+
+#endif
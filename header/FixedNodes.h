@@ -0,0 +1,104 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+
+#ifndef FIXED_NODES_H
+#define FIXED_NODES_H
+
+#include <iostream>
+#include <array>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+#include "Precision.h"
+#include "Kernels.h"
+
+namespace HMT
+{
+
+/**
+*	a plate whose size is fixed at compile time, for the many tiny plates a
+*	job solves over and over: both generations and the fixed-node mask are
+*	std::arrays inside the object, so building, solving and dropping one
+*	never touches the heap, and every index is a compile-time stride
+*
+*	solves Jacobi with the same update and stopping rule as Nodes<T> under
+*	the default ConvergencePolicy, so both give bitwise the same grid; rows
+*	up to maxUnrolledRow interior nodes are expanded node by node, longer
+*	ones go through the runtime-dispatched Kernels::jacobiRow
+**/
+template<typename T, uint64_t NX, uint64_t NY>
+class FixedNodes
+{
+	static_assert(NX >= 3 && NY >= 3, "a plate needs at least one interior node");
+
+public:
+	static const uint64_t nodeX = NX, nodeY = NY;
+	static const uint64_t maxUnrolledRow = 32;
+
+	FixedNodes(void) noexcept(true);
+	virtual ~FixedNodes() = default;
+
+	void setWallTemp(const T& northTemp, const T& eastTemp, const T& southTemp, const T& westTemp) noexcept(true);
+	void setHeatSource(const uint64_t& posX, const uint64_t& posY, const T& temp) noexcept(true);
+	// 0 for no limit, otherwise the solve stops unconverged at this count
+	void setMaxItterations(const uint64_t& maxItterations) noexcept(true);
+	void calculate(const prec_t epsilon) noexcept(true);
+	bool hasConverged(void) const noexcept(true);
+	T getTemp(const uint64_t& posX, const uint64_t& posY) const noexcept(true);
+	uint64_t getItterCount(void) const noexcept(true);
+
+	static constexpr uint64_t index(const uint64_t posX, const uint64_t posY) noexcept(true)
+	{
+		return posY * NX + posX;
+	}
+
+	template<typename T1, uint64_t NX1, uint64_t NY1>
+	friend std::ostream& operator<<(std::ostream&, const FixedNodes<T1, NX1, NY1>&);
+
+protected:
+	static prec_t sweep(const T* src, T* dst, const uint8_t* isHeatSource) noexcept(true);
+	template<std::size_t... J>
+	static T sweepRow(const T* src, T* dst, const uint8_t* isHeatSource, std::index_sequence<J...>) noexcept(true);
+	static T sweepNode(const T* src, T* dst, const uint8_t* isHeatSource, const uint64_t k) noexcept(true);
+
+private:
+	// on a cache line for the vector kernels; plain operator new only honours
+	// this from C++17, so in C++14 keep the plates on the stack or as members
+	alignas(64) std::array<T, NX * NY> _nodes;
+	alignas(64) std::array<T, NX * NY> _nodesOld;
+	std::array<uint8_t, NX * NY> _isHeatSource;
+	uint64_t _itterCnt, _maxItterations;
+	bool _hasCalculated, _hasConverged;
+};
+
+template<typename T, uint64_t NX, uint64_t NY>
+std::ostream& operator<<(std::ostream&, const FixedNodes<T, NX, NY>&);
+
+}
+
+#include "../definition/FixedNodes.cxx"
+
+#endif
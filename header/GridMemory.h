@@ -0,0 +1,103 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+
+#ifndef GRID_MEMORY_H
+#define GRID_MEMORY_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace HMT
+{
+
+enum class HugePages
+{
+	Off,			// ordinary 4 KB pages
+	Transparent,	// 2 MB aligned mapping advised with MADV_HUGEPAGE
+	Explicit		// MAP_HUGETLB from the reserved pool, Transparent if it is empty
+};
+
+/**
+*	how grid sized blocks of AlignedAllocator are backed, and whether threaded
+*	solves move each worker's rows onto the NUMA node it runs on; the defaults
+*	keep the old behaviour apart from blocks being mapped directly
+**/
+struct GridMemoryPolicy
+{
+	HugePages hugePages = HugePages::Off;
+	// Jacobi, RedBlackSOR and ADI on threads re-fault every worker's row band from that worker
+	bool firstTouch = false;
+	// pool workers stay on one CPU each, first touch is only worth it if they do not wander
+	bool pinWorkers = false;
+};
+
+struct GridMemoryStats
+{
+	uint64_t mappedBytes;		// live, rounded up to whole huge pages
+	uint64_t transparentBytes;	// live and advised MADV_HUGEPAGE
+	uint64_t explicitBytes;		// live and from the hugetlb pool
+	uint64_t fallbacks;			// mappings that got less than the policy asked for
+	uint64_t placedBytes;		// re-faulted by a worker since start-up
+};
+
+/**
+*	process wide backing of the grid buffers; AlignedAllocator maps every block
+*	of at least mapThreshold bytes through here, whatever the policy, so a
+*	block is freed the same way it was made even if the policy changed since
+**/
+class GridMemory
+{
+public:
+	static constexpr std::size_t hugePageSize = 2 << 20;
+	static constexpr std::size_t mapThreshold = hugePageSize;
+	// a mapping starts on a huge page and its block colourStride * k bytes in,
+	// k cycling through colours: huge pages are physically contiguous, so two
+	// generations at the same offset would fight over the same L1 and L2 sets
+	static constexpr std::size_t colourStride = 4096 + 64;
+	static constexpr unsigned int colours = 8;
+
+	static void setPolicy(const GridMemoryPolicy& policy) noexcept(true);
+	static GridMemoryPolicy getPolicy(void) noexcept(true);
+	static GridMemoryStats getStats(void) noexcept(true);
+
+	static bool isMapped(const std::size_t& bytes) noexcept(true);
+	// nullptr if the kernel refuses even plain pages
+	static void* map(const std::size_t& bytes) noexcept(true);
+	static void unmap(void* ptr, const std::size_t& bytes) noexcept(true);
+	// drops every whole huge page inside [ptr, ptr + bytes) and writes it back
+	// from the calling thread, whose first touch then picks the node; returns
+	// the bytes moved, 0 for a range smaller than a huge page
+	static uint64_t place(void* ptr, const std::size_t& bytes) noexcept(true);
+	// pins the calling thread to the slot-th CPU it is allowed on (modulo their count)
+	static bool pinThread(const unsigned int slot) noexcept(true);
+	// AnonHugePages plus hugetlb pages of the process, -1 without /proc
+	static int64_t residentHugeBytes(void);
+};
+
+}
+
+#include "../definition/GridMemory.cxx"
+
+#endif
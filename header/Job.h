@@ -0,0 +1,108 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+#ifndef JOB_H
+#define JOB_H
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+#include "Precision.h"
+#include "Nodes.h"
+#include "ResultWriter.h"
+
+namespace HMT
+{
+
+/**
+*	everything NodesHelper::init used to ask for on cin, plus how to solve
+*	and where the result goes
+**/
+template<typename T>
+struct JobSpec
+{
+	std::string name;
+	uint64_t lenX = 0, lenY = 0, dX = 1, dY = 1;
+	T tempNorth = 0, tempEast = 0, tempSouth = 0, tempWest = 0;
+	std::vector<std::pair<std::pair<uint64_t, uint64_t>, T>> heatSources;
+	prec_t epsilon = 0;
+	SolverMode solverMode = SolverMode::Jacobi;
+	// 1 solves serially, 0 uses every hardware thread
+	unsigned int threadCnt = 1;
+	// nothing is written while this is empty
+	std::string outputPath;
+	ResultFormat outputFormat = ResultFormat::Csv;
+	unsigned int precision = 6;
+};
+
+/**
+*	job file reader; one "key = value" per line, '#' starts a comment and
+*	"[job]" starts the next job, keys seen before the first "[job]" are the
+*	defaults of every job after them:
+*
+*		solver = multigrid
+*		[job]
+*		name = hot-corner
+*		length = 120 300
+*		spacing = 10 10
+*		walls = 500 100 100 100
+*		heatSource = 2 2 300
+*		epsilon = 1e-7
+*		threads = 4
+*		output = ./hot-corner.vti
+*		format = vtk
+*
+*	solver is one of jacobi, sor, multigrid, cg, tiled, mixed, adi, inplace,
+*	outofcore (through an unlinked temporary store), distributed (threads then
+*	counts processes); format one of csv, raw, vtk;
+*	heatSource may repeat
+**/
+class JobFile
+{
+public:
+	template<typename T>
+	static bool load(const std::string& path, std::vector<JobSpec<T>>& jobs, std::string& error);
+	template<typename T>
+	static bool parse(std::istream& in, std::vector<JobSpec<T>>& jobs, std::string& error);
+	// empty when the job can run, otherwise what is wrong with it
+	template<typename T>
+	static std::string validate(const JobSpec<T>& job);
+
+protected:
+	template<typename T>
+	static bool setKey(JobSpec<T>& job, const std::string& key, std::istringstream& value, std::string& error);
+	static bool parseSolverMode(const std::string& name, SolverMode& mode) noexcept(true);
+	static bool parseFormat(const std::string& name, ResultFormat& format) noexcept(true);
+	static std::string trim(const std::string& text);
+};
+
+}
+
+#include "../definition/Job.cxx"
+
+#endif
@@ -0,0 +1,77 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+#ifndef JOB_RUNNER_H
+#define JOB_RUNNER_H
+
+#include <iostream>
+#include <string>
+#include <deque>
+#include <cstdint>
+
+#include "Precision.h"
+#include "Job.h"
+#include "NodesHelper.h"
+
+namespace HMT
+{
+
+/**
+*	solves a queue of jobs in one process without touching cin; every job
+*	(and every job file that does not parse) leaves one JSON line on the log:
+*
+*		{"job":"hot-corner","status":"ok","nodeX":12,"nodeY":30,"itterations":732,
+*		 "converged":true,"setupNs":...,"solveNs":...,"writeNs":...,"output":"..."}
+*
+*	status is "ok", "invalid" (never ran, see "error") or "failed" (the
+*	result could not be written)
+**/
+template<typename T>
+class JobRunner
+{
+public:
+	explicit JobRunner(std::ostream& log);
+	virtual ~JobRunner() = default;
+
+	// queues every job of the file, false (and a log line) if it does not parse
+	bool enqueue(const std::string& path);
+	void enqueue(const JobSpec<T>& job);
+	uint64_t size(void) const noexcept(true);
+	// solves and drains the queue in order, returns how many jobs were not ok
+	uint64_t run(void);
+
+protected:
+	bool runOne(const JobSpec<T>& job);
+	static std::string quote(const std::string& text);
+
+private:
+	std::ostream& _log;
+	std::deque<JobSpec<T>> _queue;
+};
+
+}
+
+#include "../definition/JobRunner.cxx"
+
+#endif
@@ -0,0 +1,78 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+#ifndef KERNELS_H
+#define KERNELS_H
+
+#include <cstdint>
+
+#include "Precision.h"
+
+namespace HMT
+{
+
+enum class SimdIsa
+{
+	Scalar,
+	SSE41,
+	AVX2,
+	AVX512
+};
+
+/**
+*	row kernels for the Jacobi sweep
+*
+*	float and double rows go through explicit SIMD code picked at run time
+*	from what the CPU reports; every other type (long double in particular)
+*	takes the scalar loop, which stays the reference the vector paths must
+*	reproduce bit for bit
+**/
+namespace Kernels
+{
+
+// best instruction set this CPU supports
+SimdIsa detectIsa(void) noexcept(true);
+// instruction set the float/double kernels currently use
+SimdIsa activeIsa(void) noexcept(true);
+// pins the kernels to isa, clamped to detectIsa(); mostly for tests and benchmarks
+void setIsa(const SimdIsa isa) noexcept(true);
+const char* isaName(const SimdIsa isa) noexcept(true);
+
+// out[j] = isFixed[j] ? row[j] : (north[j] + south[j] + row[j - 1] + row[j + 1]) / 4
+// for j in [begin, end), returns max |out[j] - row[j]|
+template<typename T>
+prec_t jacobiRow(const T* north, const T* row, const T* south, const uint8_t* isFixed,
+	T* out, const uint64_t& begin, const uint64_t& end) noexcept(true);
+// same update without tracking the change, for sweeps that skip the convergence check
+template<typename T>
+void jacobiRowUpdate(const T* north, const T* row, const T* south, const uint8_t* isFixed,
+	T* out, const uint64_t& begin, const uint64_t& end) noexcept(true);
+
+}
+
+}
+
+#include "../definition/Kernels.cxx"
+
+#endif
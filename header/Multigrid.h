@@ -0,0 +1,96 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+#ifndef MULTIGRID_H
+#define MULTIGRID_H
+
+#include <vector>
+#include <cstdint>
+
+#include "Precision.h"
+#include "SolveControl.h"
+
+namespace HMT
+{
+
+/**
+*	geometric multigrid for the 5-point Laplace problem solved by Nodes<T>
+*
+*	walls and nodes flagged in isFixed are Dirichlet constraints and take no
+*	correction; coarse operators are Galerkin products R A P of the masked
+*	fine operator, so interior fixed nodes and odd plate sizes stay consistent
+*	across levels without any special casing in the smoother
+**/
+template<typename T>
+class Multigrid
+{
+public:
+	Multigrid(const uint64_t& nodeX, const uint64_t& nodeY, const uint8_t* isFixed);
+	virtual ~Multigrid(void) = default;
+
+	void setSmoothing(const unsigned int preSmooth, const unsigned int postSmooth) noexcept(true);
+	// polled after every cycle, nullptr for none; solve() returns early once it says stop
+	void setSolveControl(SolveControl* control) noexcept(true);
+	// iterates V-cycles on grid until the largest Jacobi update would be below epsilon;
+	// fullMultigrid starts with a nested-iteration pass over the initial defect
+	uint64_t solve(T* grid, const prec_t& epsilon, const bool fullMultigrid);
+	// largest |(N + S + E + W) / 4 - u| over the free nodes, the change a Jacobi sweep would make
+	prec_t residual(const T* grid) const;
+	// one entry per cycle, the residual() after it
+	const std::vector<prec_t>& getResidualHistory(void) const noexcept(true);
+	uint64_t getLevelCount(void) const noexcept(true);
+	// everything the levels hold, masks, stencils and work grids
+	uint64_t getBytes(void) const noexcept(true);
+
+protected:
+	struct Level
+	{
+		uint64_t nodeX, nodeY;
+		std::vector<uint8_t> isFixed;
+		// 3x3 stencil per node on coarse levels, empty on the finest (4u - N - S - E - W)
+		std::vector<T> stencil;
+		std::vector<T> u, f, r;
+	};
+
+	void buildCoarse(const Level& fine, Level& coarse);
+	void applyOperator(const Level& level, const T* u, T* out) const;
+	void vCycle(const uint64_t& level, T* u, const T* f);
+	void fullMultigrid(const uint64_t& level, T* u, const T* f);
+	void smooth(const Level& level, T* u, const T* f, const unsigned int sweeps) const;
+	void computeResidual(const Level& level, const T* u, const T* f, T* r) const;
+	void restrictResidual(const Level& fine, const T* r, const Level& coarse, T* f) const;
+	void prolongate(const Level& coarse, const T* e, const Level& fine, T* u) const;
+
+private:
+	std::vector<Level> _levels;
+	unsigned int _preSmooth, _postSmooth;
+	std::vector<prec_t> _residualHistory;
+	SolveControl* _control;
+};
+
+}
+
+#include "../definition/Multigrid.cxx"
+
+#endif
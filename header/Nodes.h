@@ -32,29 +32,170 @@ SOFTWARE.
 #include <cstdint>
 #include <chrono>
 #include <thread>
+#include <memory>
+#include <string>
+#include <functional>
+
+#include "Precision.h"
+#include "AlignedAllocator.h"
+#include "GridMemory.h"
+#include "Kernels.h"
+#include "ThreadPool.h"
+#include "Convergence.h"
+#include "Checkpoint.h"
+#include "ResultWriter.h"
+#include "Telemetry.h"
+#include "SolveControl.h"
+#include "Multigrid.h"
+#include "ConjugateGradient.h"
+#include "Distributed.h"
+#include "TileStore.h"
 
-using prec_t = long double;
 
 namespace HMT
 {
 
+enum class SolverMode
+{
+	Jacobi,			// two generations, one neighbour hop per sweep
+	RedBlackSOR,	// in place, over-relaxed, colours updated alternately
+	Multigrid,		// full multigrid start followed by V-cycles, for large plates
+	ConjugateGradient,	// matrix-free preconditioned CG, stops on the true l2 residual
+	TiledJacobi,	// Jacobi run several sweeps at a time per cache-sized tile
+	MixedPrecision,	// Jacobi in float/double, then defect correction in T
+	Distributed,	// Jacobi over row bands owned by forked processes, halos in shared memory
+	ADI,			// Peaceman-Rachford: implicit row, then column half-steps, Thomas per line
+	InPlace,		// Jacobi in one generation, each new row held back a row
+	OutOfCore		// Jacobi streamed band by band through a file, several sweeps per band load
+};
+
+enum class LowPrecision
+{
+	Float,
+	Double
+};
+
+struct TileShape
+{
+	uint64_t rows, cols;	// interior nodes owned by one tile
+	unsigned int steps;		// sweeps applied per tile load
+};
+
+struct MemoryFootprint
+{
+	uint64_t gridBytes, maskBytes;	// held by the plate right now
+	uint64_t scratchBytes;			// the most the last solve allocated on top of them
+	uint64_t peakBytes;				// grids, mask and scratch at the high point of the last solve
+};
+
 template<typename T>
 class Nodes
 {
 public:
 	Nodes() = default;
 	Nodes(const uint64_t& nodeX, const uint64_t& nodeY);
+	// a plate that lives in a TileStore at storePath (empty for an unlinked temporary
+	// file) and never in memory: edits, getTemp, writeResult and operator<< go through
+	// the file, every solve streams OutOfCore, there is no checkpoint or pre-smoothing,
+	// and copies share the file until detachShared()
+	Nodes(const uint64_t& nodeX, const uint64_t& nodeY, const std::string& storePath);
 	virtual ~Nodes() = default;
 
 	void setWallTemp(const T& northTemp, const T& eastTemp, const T& southTemp, const T& westTemp);
 	void setHeatSource(const uint64_t& posX, const uint64_t& posY, const T& temp);
+	// frees the node again; it starts from the mean of its four neighbours, or
+	// goes back to its wall's temperature on a wall
+	void removeHeatSource(const uint64_t& posX, const uint64_t& posY);
+	// once solved, wall and heat source edits keep the last solution as the
+	// starting guess instead of resetting the interior
+	void setWarmStart(const bool choice) noexcept(true);
+	// overwrites every free interior node with grid (nodeX * nodeY values,
+	// row-major); a warm start then begins the next solve from it
+	void setInitialGuess(const T* grid);
+	bool getWarmStart(void) const noexcept(true);
+	// before a warm re-solve, sweeps Gauss-Seidel passes over every edited node
+	// and radius nodes around it (a whole strip for a wall); 0 sweeps is off
+	void setPreSmoothing(const uint64_t& radius, const unsigned int sweeps) noexcept(true);
 	void canUseThreads(const bool choice) noexcept(true);
 	bool canUseThreads(void) const noexcept(true);
+	// 0 picks std::thread::hardware_concurrency(), capped to the interior rows
+	void setThreadCount(const unsigned int threadCnt) noexcept(true);
+	unsigned int getThreadCount(void) const noexcept(true);
+	// ranks of the Distributed mode, 0 picks std::thread::hardware_concurrency(),
+	// capped to the interior rows
+	void setProcessCount(const unsigned int processCnt) noexcept(true);
+	unsigned int getProcessCount(void) const noexcept(true);
+	void setSolverMode(const SolverMode mode) noexcept(true);
+	SolverMode getSolverMode(void) const noexcept(true);
+	// omega for RedBlackSOR, anything <= 0 estimates the optimum from the grid size
+	void setRelaxation(const prec_t omega) noexcept(true);
+	prec_t getRelaxation(void) const noexcept(true);
+	// SSOR uses getRelaxation() as its omega
+	void setPreconditioner(const Preconditioner preconditioner) noexcept(true);
+	Preconditioner getPreconditioner(void) const noexcept(true);
+	// tile for TiledJacobi, any zero field lets autotuneTiling() choose
+	void setTiling(const TileShape& shape) noexcept(true);
+	TileShape getTiling(void) const noexcept(true);
+	// working type for the bulk of the MixedPrecision sweeps
+	void setLowPrecision(const LowPrecision precision) noexcept(true);
+	LowPrecision getLowPrecision(void) const noexcept(true);
+	// sweeps the last MixedPrecision solve ran in the low type and in T
+	uint64_t getLowPrecisionSweeps(void) const noexcept(true);
+	uint64_t getHighPrecisionSweeps(void) const noexcept(true);
+	// stopping rule of the Jacobi mode, serial and threaded; TiledJacobi keeps to its budget
+	void setConvergencePolicy(const ConvergencePolicy& policy) noexcept(true);
+	ConvergencePolicy getConvergencePolicy(void) const noexcept(true);
+	// false if the last solve ran out of its iteration or time budget first
+	bool hasConverged(void) const noexcept(true);
+	// snapshot of the current grid, fixed nodes, iteration count and last residual
+	bool saveCheckpoint(const std::string& path) const;
+	// replaces size, grid and heat sources with a snapshot written for the same T;
+	// the next Jacobi or RedBlackSOR solve carries on counting from its iteration
+	bool loadCheckpoint(const std::string& path);
+	// exports the current grid; precision is the CSV digits after the point
+	bool writeResult(const std::string& path, const ResultFormat format, const unsigned int precision) const;
+	// Jacobi and RedBlackSOR solves rewrite path every everySweeps sweeps, 0 turns it off
+	void setCheckpointing(const std::string& path, const uint64_t& everySweeps);
+	// Jacobi and RedBlackSOR solves report every sweep to it, nullptr detaches
+	void setTelemetry(const std::shared_ptr<Telemetry>& telemetry) noexcept(true);
+	std::shared_ptr<Telemetry> getTelemetry(void) const noexcept(true);
+	// every solver mode polls it once per iteration, nullptr detaches; a solve it
+	// stops keeps the grid it got to and reports hasConverged() false
+	void setSolveControl(const std::shared_ptr<SolveControl>& control) noexcept(true);
+	std::shared_ptr<SolveControl> getSolveControl(void) const noexcept(true);
+	// a copy shares the thread pool, telemetry, SolveControl, checkpoint path and
+	// store of the plate it was copied from; this gives it a pool and a store of its
+	// own and drops the rest
+	void detachShared(void);
+	// OutOfCore store file (empty for an unlinked temporary one, a store-backed plate
+	// keeps the one it was made with), interior rows per band and sweeps per band
+	// load; a zero band picks about 4 MB of rows, and a non-zero memoryCap shrinks
+	// bands until their buffers fit in it. It stops on max change as TiledJacobi
+	// does, and at the policy's maxItterations
+	void setStreaming(const std::string& path, const uint64_t& bandRows, const unsigned int steps,
+		const uint64_t& memoryCap = 0);
+	// I/O, stalls and pass time of the last OutOfCore solve
+	StreamStats getStreamStats(void) const noexcept(true);
+	// sizes tiles to the host caches and times a trial block per candidate step count
+	void autotuneTiling(void);
 	void calculate(const prec_t epsilon);
 	bool hasHeatSource(void) const noexcept(true);
 	T getTemp(const uint64_t& posX, const uint64_t& posY) const;
 	std::chrono::nanoseconds getDuration(void) const;
 	uint64_t getItterCount(void) const;
+	// the stopping quantity after every iteration (every checked sweep for Jacobi):
+	// the ConvergencePolicy norm for Jacobi, max change for SOR,
+	// max Jacobi update per cycle for Multigrid and per shift cycle for ADI,
+	// l2 residual / 4 for ConjugateGradient;
+	// Distributed hands back the last one only
+	const std::vector<prec_t>& getResidualHistory(void) const noexcept(true);
+	// only Jacobi, TiledJacobi, ADI and Distributed keep a second generation, and only
+	// once they have run; the others free it, OutOfCore the grid and mask too while it
+	// streams. A store-backed plate holds neither, only the scratch of its solves
+	MemoryFootprint getMemoryFootprint(void) const noexcept(true);
+
+	// consecutive ADI shifts are at most this factor apart
+	static constexpr double adiShiftRatio = 4.0;
 
 	template<typename T1> friend std::ostream& operator<<(std::ostream&, const Nodes<T1>&);
 
@@ -62,12 +203,114 @@ public:
 
 protected:
 	void initBuffer(void);
+	// every setting of a new plate, the buffers apart
+	void initState(void);
+	// the grid and mask one node at a time, in memory or in the store; a store
+	// write goes to both generations
+	T nodeAt(const uint64_t& k) const;
+	bool isFixedAt(const uint64_t& k) const;
+	void setNodeAt(const uint64_t& k, const T& value, const uint8_t isFixed);
+	bool anyFixed(void) const;
+	// row of the grid; a store-backed plate reads about a megabyte of rows into
+	// chunk at a time, chunkBegin its first row. nullptr if the store fails
+	const T* rowAt(const uint64_t& row, std::vector<T>& chunk, uint64_t& chunkBegin) const;
+	// reads each row of the store's current generation and its mask, lets edit
+	// change the values and writes the row to both generations
+	void editStoreRows(const std::function<void(const uint64_t&, T*, const uint8_t*)>& edit);
 	void calculateWThread(const prec_t& epsilon);
+	prec_t jacobiSweep(const T* src, T* dst, const uint64_t& rowBegin, const uint64_t& rowEnd) const;
+	void calculateJacobi(const prec_t& epsilon);
+	void markEdited(const uint64_t& x0, const uint64_t& y0, const uint64_t& x1, const uint64_t& y1);
+	void preSmooth(void);
+	void publishSweep(SweepRecord& record, const uint64_t& itterCnt, const prec_t& residual,
+		const std::chrono::high_resolution_clock::time_point& sweepStart) const;
+	bool isCheckpointSweep(const uint64_t& itterCnt) const noexcept(true);
+	// false without a SolveControl
+	bool isStopRequested(const uint64_t& itterCnt, const prec_t& residual) const noexcept(true);
+	bool writeCheckpoint(const std::string& path, const T* grid, const uint64_t& itterCnt,
+		const prec_t& residual) const;
+	// sweep that measures what the policy norm needs on checked sweeps only:
+	// max |change| for LInf, sum of squared changes otherwise, 0 when unchecked
+	prec_t policySweep(const T* src, T* dst, const uint64_t& rowBegin, const uint64_t& rowEnd,
+		const bool isCheck, const Norm norm) const;
+	void calculateSOR(const prec_t& epsilon);
+	prec_t sorSweep(T* grid, const unsigned int color, const prec_t& omega,
+		const uint64_t& rowBegin, const uint64_t& rowEnd) const;
+	ThreadPool& threadPool(const unsigned int nofThreads);
+	// under GridMemoryPolicy::firstTouch, hands every worker's row band of both
+	// generations and the mask to that worker to fault in; once per layout
+	void placeBuffers(ThreadPool& threadPool, const unsigned int nofThreads);
+	// shift cycle of ADI, largest first
+	std::vector<prec_t> adiShifts(void) const;
+	void calculateADI(const prec_t& epsilon);
+	// one implicit half-step over rows [rowBegin, rowEnd) or columns
+	// [colBegin, colEnd): src holds the previous step, dst takes the line solutions
+	void rowLineSolve(const T* src, T* dst, uint64_t* run, const T* inv, const prec_t& shift,
+		const uint64_t& rowBegin, const uint64_t& rowEnd) const;
+	void columnLineSolve(const T* src, T* dst, const uint32_t* run, const T* inv, const prec_t& shift,
+		const uint64_t& colBegin, const uint64_t& colEnd) const;
+	void calculateMultigrid(const prec_t& epsilon);
+	void calculateConjugateGradient(const prec_t& epsilon);
+	void calculateTiled(const prec_t& epsilon);
+	void tiledBlock(const T* src, T* dst, const unsigned int steps, prec_t* stepDiffs);
+	template<typename L> void calculateMixed(const prec_t& epsilon);
+	void calculateDistributed(const prec_t& epsilon);
+	void calculateInPlace(const prec_t& epsilon);
+	void calculateOutOfCore(const prec_t& epsilon);
+	// grids and mask as allocated now
+	uint64_t heldBytes(void) const noexcept(true);
+	// a solve holds bytes of scratch besides the grids and mask at this point
+	void noteScratch(const uint64_t& bytes) noexcept(true);
+	// the sweep loop of one rank; it owns interior rows [rowBegin, rowEnd)
+	bool distributedRank(HaloExchange& exchange, const prec_t& epsilon,
+		const uint64_t& rowBegin, const uint64_t& rowEnd);
+	template<typename L> prec_t lowSweep(const L* src, L* dst, const L* rhs) const;
+	uint64_t index(const uint64_t& posX, const uint64_t& posY) const noexcept(true);
 		
 private:
 	bool _hasHeatSource, _hasCalculated, _canUseThreads;
+	// edits since the last solve, as [x0, x1) x [y0, y1) boxes
+	struct Region { uint64_t x0, y0, x1, y1; };
+	std::vector<Region> _edited;
+	bool _warmStart, _hasSolution;
+	uint64_t _smoothRadius;
+	unsigned int _smoothSweeps;
 	uint64_t _nodeX, _nodeY, _itterCnt;
-	std::vector<std::vector<std::pair<T, bool>>> _nodes, _nodesOld;
+	// north, east, south, west as setWallTemp last set them
+	T _wallTemp[4];
+	unsigned int _threadCnt, _processCnt;
+	SolverMode _solverMode;
+	Preconditioner _preconditioner;
+	prec_t _omega;
+	TileShape _tiling;
+	std::vector<AlignedVector<T>> _tileScratch;
+	std::string _streamPath;
+	uint64_t _streamBandRows, _streamCap;
+	unsigned int _streamSteps;
+	StreamStats _streamStats;
+	LowPrecision _lowPrecision;
+	uint64_t _lowSweeps, _highSweeps;
+	std::vector<prec_t> _residualHistory;
+	uint64_t _scratchBytes, _peakBytes;
+	ConvergencePolicy _convergence;
+	bool _hasConverged;
+	std::string _checkpointPath;
+	uint64_t _checkpointEvery, _restartItterCnt;
+	std::shared_ptr<ThreadPool> _threadPool;
+	std::shared_ptr<Telemetry> _telemetry;
+	std::shared_ptr<SolveControl> _control;
+	// row-major temperature buffers, one contiguous block per generation
+	AlignedVector<T> _nodes, _nodesOld;
+	// non-zero where the node is held at a fixed temp by setHeatSource
+	AlignedVector<uint8_t> _isHeatSource;
+	// a store-backed plate's grid instead of the three above: two generations
+	// laid out as calculateOutOfCore lays them out, _storeGen the byte offset of
+	// the current one, then the mask at _storeMask
+	std::shared_ptr<TileStore> _store;
+	uint64_t _storeGen, _storeMask;
+	// buffers and thread count placeBuffers last ran for
+	const void* _placedGrids[3];
+	unsigned int _placedThreads;
 	std::chrono::time_point<std::chrono::high_resolution_clock> _startTime, _endTime;
 };
 
@@ -32,6 +32,8 @@ SOFTWARE.
 #include <chrono>
 
 #include "Nodes.h"
+#include "Job.h"
+#include "AsyncSolver.h"
 
 namespace HMT
 {
@@ -44,10 +46,17 @@ public:
 	virtual ~NodesHelper(void) = default;
 
 	void init(void);
+	// the same setup from a job instead of prompts on cin
+	void init(const JobSpec<T>& job);
 	void addHeatSource(std::initializer_list<std::pair<std::pair<uint64_t, uint64_t>, T>>&);
 	void canUseThreads(const bool choice) noexcept(true);
 	bool canUseThreads(void) noexcept(true);
 	void calculate(void);
+	void calculate(const prec_t epsilon);
+	// solves a copy on AsyncSolver<T>::shared() and returns at once; this helper keeps its unsolved plate
+	SolveHandle<T> calculateAsync(const prec_t epsilon,
+		const SolveControl::clock::time_point& deadline = SolveControl::clock::time_point::max());
+	const Nodes<T>& getNodes(void) const noexcept(true);
 
 	template<typename durationFormat> durationFormat getDuration() const;
 
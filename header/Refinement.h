@@ -0,0 +1,128 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+#ifndef REFINEMENT_H
+#define REFINEMENT_H
+
+#include <vector>
+#include <memory>
+#include <utility>
+#include <cstdint>
+
+#include "Precision.h"
+#include "Nodes.h"
+
+namespace HMT
+{
+
+// inclusive box of nodes on the parent level
+struct PatchBox
+{
+	uint64_t x0, y0, x1, y1;
+};
+
+/**
+*	locally refined plate: a uniform level plus nested patches, each patch
+*	ratio times finer over its box of the level above and refinable itself
+*
+*	levels are coupled by overlapping Schwarz iteration: a patch takes its
+*	boundary ring from its parent by bilinear interpolation, the parent then
+*	holds the nodes lying at least overlap nodes inside the patch at the
+*	patch's values, and both are re-solved (warm) until the ring stops moving
+*	by more than epsilon; every level is an ordinary Nodes solve
+**/
+template<typename T>
+class RefinedNodes
+{
+public:
+	// parent nodes kept free between a patch edge and the nodes it drives
+	static const uint64_t overlap = 2;
+
+	RefinedNodes(const uint64_t& nodeX, const uint64_t& nodeY);
+	RefinedNodes(const RefinedNodes&) = delete;
+	RefinedNodes& operator=(const RefinedNodes&) = delete;
+	virtual ~RefinedNodes() = default;
+
+	// walls of the top level only, a patch takes its edges from its parent
+	void setWallTemp(const T& northTemp, const T& eastTemp, const T& southTemp, const T& westTemp);
+	// position in this level's nodes; patches covering it get it too, also ones added later
+	void setHeatSource(const uint64_t& posX, const uint64_t& posY, const T& temp);
+	// for this level and every patch below it
+	void setSolverMode(const SolverMode mode);
+	// coupling iterations per calculate() before it gives up, at every level
+	void setMaxCouplings(const uint64_t& maxCouplings);
+
+	// nullptr if the box is degenerate, off the level, overlaps a patch or ratio < 2
+	RefinedNodes<T>* addPatch(const PatchBox& box, const unsigned int ratio);
+	// a radius-node box around every heat source, overlapping boxes merged; returns patches added
+	uint64_t refineAroundHeatSources(const uint64_t& radius, const unsigned int ratio);
+	// solves this level and refines every region where |grad T| (per node spacing)
+	// exceeds threshold, grown by margin nodes; returns patches added
+	uint64_t refineGradient(const prec_t& threshold, const uint64_t& margin, const unsigned int ratio,
+		const prec_t& epsilon);
+
+	void calculate(const prec_t epsilon);
+	// at (x, y) in this level's node units, from the finest level covering it
+	T getTemp(const prec_t& x, const prec_t& y) const;
+	const Nodes<T>& getNodes(void) const noexcept(true);
+	uint64_t getPatchCount(void) const noexcept(true);
+	RefinedNodes<T>& getPatch(const uint64_t& patch);
+	const PatchBox& getBox(void) const noexcept(true);
+	unsigned int getRatio(void) const noexcept(true);
+	// nodes of this level and every patch below it
+	uint64_t getCellCount(void) const noexcept(true);
+	// coupling iterations the last calculate() ran on this level
+	uint64_t getCouplingCount(void) const noexcept(true);
+	// false if this level or a patch below it ran out of coupling iterations
+	bool hasConverged(void) const noexcept(true);
+
+protected:
+	RefinedNodes(const RefinedNodes<T>& parent, const PatchBox& box, const unsigned int ratio);
+	uint64_t addPatches(std::vector<PatchBox> boxes, const unsigned int ratio);
+	bool isFree(const PatchBox& box) const noexcept(true);
+	// bilinear on this level's own grid, patches ignored
+	T sample(const prec_t& x, const prec_t& y) const;
+	// sets the boundary ring from parent, returns the largest change
+	prec_t pullBoundary(const RefinedNodes<T>& parent);
+	void pushInterior(RefinedNodes<T>& parent) const;
+
+private:
+	uint64_t _nodeX, _nodeY;
+	PatchBox _box;
+	unsigned int _ratio;
+	SolverMode _solverMode;
+	uint64_t _maxCouplings, _couplingCnt;
+	bool _hasConverged, _hasGuess;
+	Nodes<T> _nodes;
+	// heat sources set on this level or handed down, they never take coupled values
+	std::vector<std::pair<std::pair<uint64_t, uint64_t>, T>> _heatSources;
+	std::vector<uint8_t> _isHeatSource;
+	std::vector<std::unique_ptr<RefinedNodes<T>>> _patches;
+};
+
+}
+
+#include "../definition/Refinement.cxx"
+
+#endif
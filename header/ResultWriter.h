@@ -0,0 +1,106 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+#ifndef RESULT_WRITER_H
+#define RESULT_WRITER_H
+
+#include <string>
+#include <type_traits>
+#include <cstdint>
+#include <sys/uio.h>
+
+#include "Precision.h"
+
+namespace HMT
+{
+
+enum class ResultFormat
+{
+	Csv,	// one plate row per line, fixed-point values separated by ','
+	Raw,	// row-major values, little-endian, no header
+	Vtk		// VTK XML ImageData (.vti) with the values appended raw, opens in ParaView
+};
+
+/**
+*	exports of a solved row-major grid; every format is assembled in one
+*	large buffer (or handed to writev as it sits in memory) and written with
+*	a handful of system calls instead of one stream insertion per value
+**/
+class ResultWriter
+{
+public:
+	static const uint64_t bufferSize = 1 << 20;
+	// widest field formatFixed can produce: sign, every digit of LDBL_MAX, point, maxPrecision decimals
+	static const uint64_t maxFieldWidth = 5120;
+	// decimals formatFixed writes at most; up to 18 it formats by hand, above through snprintf
+	static const unsigned int maxPrecision = 160;
+
+	// float and double are written as they are, every other type as double
+	template<typename T>
+	using Stored = typename std::conditional<std::is_same<T, float>::value, float, double>::type;
+
+	template<typename T>
+	static bool write(const std::string& path, const ResultFormat format, const uint64_t& nodeX,
+		const uint64_t& nodeY, const T* values, const unsigned int precision);
+	template<typename T>
+	static bool writeCsv(const std::string& path, const uint64_t& nodeX, const uint64_t& nodeY,
+		const T* values, const unsigned int precision);
+	template<typename T>
+	static bool writeRaw(const std::string& path, const uint64_t& nodeX, const uint64_t& nodeY, const T* values);
+	template<typename T>
+	static bool writeVtk(const std::string& path, const uint64_t& nodeX, const uint64_t& nodeY, const T* values);
+	// the same files for a grid that is not in memory as a whole: rowAt(i) hands
+	// back the nodeX values of row i, good until its next call, or nullptr if it cannot
+	template<typename T, typename RowAt>
+	static bool writeRows(const std::string& path, const ResultFormat format, const uint64_t& nodeX,
+		const uint64_t& nodeY, RowAt rowAt, const unsigned int precision);
+
+	// printf("%.*f") without the locale and varargs overhead up to 18 decimals,
+	// printf itself beyond; the last digit may round the other way on a value
+	// within an ulp of a tie.
+	// out needs maxFieldWidth chars, returns the number written (no '\0')
+	template<typename T>
+	static uint64_t formatFixed(const T& value, const unsigned int precision, char* out) noexcept(true);
+
+protected:
+	static bool isLittleEndian(void) noexcept(true);
+	// everything of a .vti before the appended values, and after them
+	template<typename T>
+	static std::string vtkHead(const uint64_t& nodeX, const uint64_t& nodeY);
+	static std::string vtkTail(void);
+	// fills buffer with Stored<T> little-endian copies of values[0, count)
+	template<typename T>
+	static void encode(const T* values, const uint64_t& count, char* buffer) noexcept(true);
+	// streams values through the encode buffer, or straight from memory when nothing changes
+	template<typename T>
+	static bool writeValues(const int fd, const T* values, const uint64_t& count);
+	static bool writeAll(const int fd, const void* data, uint64_t size);
+	static bool writeAllV(const int fd, struct iovec* parts, int partCnt);
+};
+
+}
+
+#include "../definition/ResultWriter.cxx"
+
+#endif
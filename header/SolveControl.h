@@ -0,0 +1,105 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+
+#ifndef SOLVE_CONTROL_H
+#define SOLVE_CONTROL_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "Precision.h"
+
+namespace HMT
+{
+
+enum class SolveStatus
+{
+	Queued,
+	Running,
+	Converged,
+	Unconverged,		// out of its ConvergencePolicy budget
+	Cancelled,			// stopped by cancel(), the grid is the best so far
+	DeadlineExceeded	// stopped at the deadline, the grid is the best so far
+};
+
+struct SolveProgress
+{
+	SolveStatus status;
+	uint64_t itterCnt;
+	// the last stopping quantity the solver measured, -1 before the first one
+	double residual;
+};
+
+/**
+*	the line between a running solve and whoever waits on it: the solver polls
+*	it once per iteration (per cycle for Multigrid and ADI), which publishes its
+*	progress and tells it to stop once cancelled or past the deadline; a solve
+*	stopped that way keeps its grid and reports hasConverged() false
+*
+*	the state sits in a MAP_SHARED page, so the forked ranks of the
+*	Distributed mode see a cancel issued after they started; one per solve
+**/
+class SolveControl
+{
+public:
+	typedef std::chrono::steady_clock clock;
+
+	SolveControl(void);
+	SolveControl(const SolveControl&) = delete;
+	SolveControl& operator=(const SolveControl&) = delete;
+	virtual ~SolveControl(void);
+
+	void cancel(void) noexcept(true);
+	bool isCancelled(void) const noexcept(true);
+	// clock::time_point::max() for none, the default
+	void setDeadline(const clock::time_point& deadline) noexcept(true);
+	clock::time_point getDeadline(void) const noexcept(true);
+	void setStatus(const SolveStatus status) noexcept(true);
+	SolveStatus getStatus(void) const noexcept(true);
+	SolveProgress getProgress(void) const noexcept(true);
+	// a poll has told the solver to stop
+	bool isStopped(void) const noexcept(true);
+	// records the progress; true if the solver has to stop, and from then on
+	bool poll(const uint64_t& itterCnt, const prec_t& residual) noexcept(true);
+
+private:
+	struct Shared
+	{
+		std::atomic<int> status;
+		std::atomic<bool> isCancelled;
+		std::atomic<int64_t> deadline;
+		std::atomic<uint64_t> itterCnt;
+		std::atomic<double> residual;
+	};
+	Shared* _shared;
+	bool _isMapped;
+};
+
+}
+
+#include "../definition/SolveControl.cxx"
+
+#endif
@@ -0,0 +1,136 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <cstdint>
+
+#include "Precision.h"
+
+// build with -DHMT_TELEMETRY=0 to compile every probe out of the solver loops;
+// left on, a solve without a Telemetry attached pays one branch per sweep
+#ifndef HMT_TELEMETRY
+#define HMT_TELEMETRY 1
+#endif
+
+namespace HMT
+{
+
+/**
+*	what one sweep (one red + black pass for SOR) did
+**/
+struct SweepRecord
+{
+	static const unsigned int maxThreads = 32;
+
+	uint64_t itterCnt;
+	// the stopping quantity the solve measured, negative on sweeps that skipped the check
+	prec_t residual;
+	// worker 0 from the start of the sweep until every worker is done with it
+	std::chrono::nanoseconds sweepTime;
+	// filled while Telemetry::isCounting(), 0 otherwise; bytes as STREAM counts
+	// them: every interior value read and written once plus its mask byte
+	uint64_t cellsUpdated, bytesMoved;
+	// time each worker spent computing before the barrier, the first
+	// min(threadCnt, maxThreads) entries are set
+	unsigned int threadCnt;
+	std::chrono::nanoseconds threadTimes[maxThreads];
+};
+
+/**
+*	single producer, single consumer ring of sweep records; the solving
+*	thread never waits on it, a record that finds the ring full is dropped
+**/
+class SweepRing
+{
+public:
+	// capacity is rounded up to a power of two
+	explicit SweepRing(const uint64_t& capacity);
+
+	bool push(const SweepRecord& record) noexcept(true);
+	bool pop(SweepRecord& record) noexcept(true);
+	uint64_t capacity(void) const noexcept(true);
+	uint64_t dropCount(void) const noexcept(true);
+
+private:
+	std::vector<SweepRecord> _slots;
+	uint64_t _mask;
+	// a cache line apart, so producer and consumer do not share one; padded
+	// rather than alignas(64), which plain operator new does not honour in C++14
+	std::atomic<uint64_t> _head;
+	char _headPad[64];
+	std::atomic<uint64_t> _tail;
+	char _tailPad[64];
+	std::atomic<uint64_t> _dropCnt;
+};
+
+/**
+*	instrumentation a Nodes solve reports to after every Jacobi or SOR sweep:
+*	an observer called on the solving thread, a ring another thread can
+*	drain while the solve runs, and running totals of the optional counters
+**/
+class Telemetry
+{
+public:
+	// ringCapacity 0 keeps no ring, records then only reach the observer
+	explicit Telemetry(const uint64_t& ringCapacity);
+	Telemetry(const Telemetry&) = delete;
+	Telemetry& operator=(const Telemetry&) = delete;
+	virtual ~Telemetry() = default;
+
+	// runs on the solving thread (worker 0) between its sweeps; the other
+	// workers cannot get more than a sweep ahead of it, so keep it short
+	void setObserver(const std::function<void(const SweepRecord&)>& observer);
+	void setCounting(const bool choice) noexcept(true);
+	bool isCounting(void) const noexcept(true);
+
+	// reader side of the ring
+	bool pop(SweepRecord& record) noexcept(true);
+	uint64_t dropCount(void) const noexcept(true);
+	// sums over every sweep published while counting
+	uint64_t getSweepCount(void) const noexcept(true);
+	uint64_t getCellsUpdated(void) const noexcept(true);
+	uint64_t getBytesMoved(void) const noexcept(true);
+
+	// solver side
+	void publish(const SweepRecord& record);
+
+private:
+	std::function<void(const SweepRecord&)> _observer;
+	std::unique_ptr<SweepRing> _ring;
+	std::atomic<bool> _isCounting;
+	std::atomic<uint64_t> _sweepCnt, _cellCnt, _byteCnt;
+};
+
+}
+
+#include "../definition/Telemetry.cxx"
+
+#endif
@@ -0,0 +1,91 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <cstdint>
+
+namespace HMT
+{
+
+/**
+*	reusable rendezvous point for a fixed number of threads, every call to
+*	wait() blocks until all of them have arrived
+**/
+class Barrier
+{
+public:
+	explicit Barrier(const unsigned int count);
+
+	void wait(void);
+	unsigned int size(void) const noexcept(true);
+
+private:
+	std::mutex _mutex;
+	std::condition_variable _cond;
+	unsigned int _count, _waiting;
+	uint64_t _generation;
+};
+
+/**
+*	persistent set of workers; run() hands the same task to every worker
+*	(the calling thread acts as worker 0) and returns once all have finished
+**/
+class ThreadPool
+{
+public:
+	explicit ThreadPool(const unsigned int threadCnt);
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+	virtual ~ThreadPool(void);
+
+	unsigned int size(void) const noexcept(true);
+	void run(const std::function<void(unsigned int)>& task);
+	Barrier& barrier(void) noexcept(true);
+
+protected:
+	void workerLoop(const unsigned int threadId);
+
+private:
+	std::vector<std::thread> _workers;
+	std::mutex _runMutex, _mutex;
+	std::condition_variable _wake, _done;
+	std::function<void(unsigned int)> _task;
+	uint64_t _generation;
+	unsigned int _pending;
+	bool _stop;
+	Barrier _barrier;
+};
+
+}
+
+#include "../definition/ThreadPool.cxx"
+
+#endif
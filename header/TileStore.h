@@ -0,0 +1,85 @@
+/**
+The MIT License (MIT)
+
+Copyright (c) 2014 Samuel Vishesh Paul
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**/
+
+
+#ifndef TILE_STORE_H
+#define TILE_STORE_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace HMT
+{
+
+/**
+*	what the last OutOfCore solve moved to and from its store; disk
+*	throughput is bytes over time, time per sweep passTime over the sweeps
+**/
+struct StreamStats
+{
+	uint64_t bytesRead, bytesWritten;
+	// inside the store's reads and writes, prefetches included
+	std::chrono::nanoseconds readTime, writeTime;
+	// a band was not in yet when the sweeps wanted it
+	std::chrono::nanoseconds stallTime;
+	// each pass streams every band once and applies several sweeps to it
+	uint64_t passes;
+	// all passes, the spill to the store and the read back excluded
+	std::chrono::nanoseconds passTime;
+};
+
+/**
+*	scratch file the OutOfCore mode pages grid rows through with pread and
+*	pwrite; it is removed again when the object goes
+**/
+class TileStore
+{
+public:
+	// an empty path makes an already unlinked file in $TMPDIR, or /tmp
+	explicit TileStore(const std::string& path);
+	TileStore(const TileStore&) = delete;
+	TileStore& operator=(const TileStore&) = delete;
+	virtual ~TileStore(void);
+
+	bool isValid(void) const noexcept(true);
+	// sizes the file up front, so the blocks of a pass need no allocation
+	bool reserve(const uint64_t& bytes);
+	// both retry short transfers and log what failed
+	bool read(const uint64_t& offset, void* data, uint64_t bytes);
+	bool write(const uint64_t& offset, const void* data, uint64_t bytes);
+	// read and write totals so far; passes, stall and pass time stay 0
+	StreamStats getStats(void) const noexcept(true);
+
+private:
+	int _fd;
+	std::string _path;
+	StreamStats _stats;
+};
+
+}
+
+#include "../definition/TileStore.cxx"
+
+#endif
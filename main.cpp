@@ -14,9 +14,14 @@
 #include <chrono>
 #include <thread>
 #include <atomic>
+#include <fstream>
+#include <string>
+#include <vector>
 
 #include "header/Nodes.h"
 #include "header/NodesHelper.h"
+#include "header/JobRunner.h"
+#include "header/Refinement.h"
 
 #include "test/test.cpp"
 
@@ -25,8 +30,6 @@ using std::clog;
 using std::cin;
 using std::make_pair;
 
-using prec_t = long double;
-
 void runTest(void)
 {
 	test::NodesWithoutHeatSrc<prec_t> testNodesWOHSrcTE{12, 30,
@@ -48,10 +51,158 @@ void runTest(void)
 		500.0f, 100.0f, 100.0f, 100.0f, 0.0000001f, true,
 		heatSrcs};
 	testNodesWHSrcWTE.test();
+
+	test::NodesThreadedMatchesSerial<prec_t> testThreadedMatchesSerial{12, 30,
+		500.0f, 100.0f, 100.0f, 100.0f, 0.0000001f, 4,
+		heatSrcs};
+	testThreadedMatchesSerial.test();
+
+	test::NodesSolverModes<prec_t> testSolverModes{12, 30,
+		500.0f, 100.0f, 100.0f, 100.0f, 0.0000001f, false,
+		heatSrcs};
+	testSolverModes.test();
+
+	// the 12x30 plate, ten times finer: a long, thin grid
+	test::NodesADI<double> testADI{120, 300,
+		500.0, 100.0, 100.0, 100.0, 0.000001, 3,
+		{make_pair(make_pair(20, 20), 300.0), make_pair(make_pair(50, 50), -1000.0)}};
+	testADI.test();
+
+	test::NodesInPlace<prec_t> testInPlace{12, 30,
+		500.0f, 100.0f, 100.0f, 100.0f, 0.0000001f, 4,
+		heatSrcs};
+	testInPlace.test();
+	test::NodesInPlace<double> testInPlaceWide{200, 150,
+		500.0, 100.0, 100.0, 100.0, 0.00001, 3,
+		{make_pair(make_pair(40, 30), 300.0), make_pair(make_pair(150, 100), -1000.0)}};
+	testInPlaceWide.test();
+
+	test::NodesOutOfCore<prec_t> testOutOfCore{12, 30,
+		500.0f, 100.0f, 100.0f, 100.0f, 0.0000001f, "./bin/test.store",
+		heatSrcs};
+	testOutOfCore.test();
+	// a 1 MB plate solved with at most 256 KB in memory
+	test::NodesStoreBacked<prec_t> testStoreBacked{128, 512,
+		500.0f, 100.0f, 100.0f, 100.0f, 0.0000001f, 200, 256 << 10, "./bin/test.backed.csv",
+		{make_pair(make_pair(20, 100), 300.0f), make_pair(make_pair(100, 400), -1000.0f)}};
+	testStoreBacked.test();
+
+	test::FixedNodesMatchesNodes<prec_t, 12, 30> testFixed{500.0f, 100.0f, 100.0f, 100.0f, 0.0000001f, 200,
+		heatSrcs};
+	testFixed.test();
+	test::FixedNodesMatchesNodes<double, 40, 40> testFixedWide{500.0, 100.0, 100.0, 100.0, 0.0000001, 20,
+		{make_pair(make_pair(2, 2), 300.0), make_pair(make_pair(5, 5), -1000.0)}};
+	testFixedWide.test();
+
+	test::NodesSimdMatchesScalar<double> testSimdDouble{37, 30,
+		500.0, 100.0, 100.0, 100.0, 0.0000001,
+		{make_pair(make_pair(2, 2), 300.0), make_pair(make_pair(5, 5), -1000.0)}};
+	testSimdDouble.test();
+	test::NodesSimdMatchesScalar<float> testSimdFloat{37, 30,
+		500.0f, 100.0f, 100.0f, 100.0f, 0.0001f,
+		{make_pair(make_pair(2, 2), 300.0f), make_pair(make_pair(5, 5), -1000.0f)}};
+	testSimdFloat.test();
+
+	test::NodesTiledMatchesJacobi<prec_t> testTiledMatchesJacobi{12, 30,
+		500.0f, 100.0f, 100.0f, 100.0f, 0.0000001f, HMT::TileShape{7, 4, 3}, 3,
+		heatSrcs};
+	testTiledMatchesJacobi.test();
+
+	test::NodesMixedPrecision<prec_t> testMixedFloat{12, 30,
+		500.0f, 100.0f, 100.0f, 100.0f, 0.0000001f, HMT::LowPrecision::Float,
+		heatSrcs};
+	testMixedFloat.test();
+	test::NodesMixedPrecision<prec_t> testMixedDouble{12, 30,
+		500.0f, 100.0f, 100.0f, 100.0f, 0.0000001f, HMT::LowPrecision::Double,
+		heatSrcs};
+	testMixedDouble.test();
+
+	test::NodesConvergencePolicy<prec_t> testConvergencePolicy{12, 30,
+		500.0f, 100.0f, 100.0f, 100.0f, 0.0000001f, 3,
+		heatSrcs};
+	testConvergencePolicy.test();
+
+	test::NodesCheckpointRestart<prec_t> testCheckpointRestart{12, 30,
+		500.0f, 100.0f, 100.0f, 100.0f, 0.0000001f, "./bin/test.checkpoint", 300,
+		heatSrcs};
+	testCheckpointRestart.test();
+
+	test::NodesWarmStart<prec_t> testWarmStart{12, 30,
+		500.0f, 100.0f, 100.0f, 100.0f, 0.0000001f, make_pair(5, 5), make_pair(6, 7),
+		heatSrcs};
+	testWarmStart.test();
+
+	// 7 plates so the last interleaved pack runs short
+	std::vector<HMT::Scenario<double>> scenarios;
+	for (uint64_t s = 0; s < 7; ++s) {
+		scenarios.push_back(HMT::Scenario<double>{500.0 + 10 * s, 100.0, 100.0 - 5 * s, 100.0,
+			{make_pair(make_pair(2, 2), 300.0 + 50 * s), make_pair(make_pair(5, 5), -1000.0)}});
+	}
+	test::BatchMatchesNodes<double> testBatchDouble{12, 30, 0.0000001, 3, scenarios};
+	testBatchDouble.test();
+	// a heat source that moves breaks the shared layout, so this one cannot interleave
+	scenarios.back().heatSources.back().first = make_pair(6, 9);
+	test::BatchMatchesNodes<double> testBatchMixedLayout{12, 30, 0.0000001, 3, scenarios};
+	testBatchMixedLayout.test();
+
+	test::ResultWritersThroughput<double> testWritersDouble{1024, 1024, 6, "./bin/test.result"};
+	testWritersDouble.test();
+	test::ResultWritersThroughput<prec_t> testWritersPrec{1024, 1024, 6, "./bin/test.result"};
+	testWritersPrec.test();
+
+	test::NodesTelemetry<prec_t> testTelemetry{12, 30,
+		500.0f, 100.0f, 100.0f, 100.0f, 0.0000001f, 3, 256,
+		heatSrcs};
+	testTelemetry.test();
+
+	test::DistributedMatchesSerial<prec_t> testDistributed{12, 30,
+		500.0f, 100.0f, 100.0f, 100.0f, 0.0000001f, {1, 3, 4, 28},
+		heatSrcs};
+	testDistributed.test();
+	test::DistributedMatchesSerial<double> testDistributedLarge{128, 128,
+		500.0, 100.0, 100.0, 100.0, 0.0001, {2, 4},
+		{make_pair(make_pair(32, 32), 300.0), make_pair(make_pair(64, 96), -1000.0)}};
+	testDistributedLarge.test();
+
+	// two bands of 4 MB per generation, each holds at least one whole huge page
+	test::GridMemoryPlacement<double> testGridMemory{1024, 1024,
+		500.0, 100.0, 100.0, 100.0, 20, 2,
+		{make_pair(make_pair(256, 256), 300.0), make_pair(make_pair(512, 768), -1000.0)}};
+	testGridMemory.test();
+
+	test::AsyncSolveControl<double> testAsync{64, 64,
+		500.0, 100.0, 100.0, 100.0, 0.0000001, std::chrono::milliseconds(20),
+		{make_pair(make_pair(16, 16), 300.0), make_pair(make_pair(32, 48), -1000.0)}};
+	testAsync.test();
+
+	test::RefinedNodesAccuracy<prec_t> testRefined{31, 31,
+		500.0f, 100.0f, 100.0f, 100.0f, 0.0000001f, 4, 4,
+		{make_pair(make_pair(10, 10), 1000.0f)}};
+	testRefined.test();
+
+	test::JobRunnerQueue<prec_t> testJobRunner{"./bin/test.jobs", "./bin/test.job.result"};
+	testJobRunner.test();
 }
 
 int main(int argc, char const *argv[])
 {
+	// main.out [--log file] jobfile...: solve the jobs without prompting, one JSON line each
+	if (argc > 1) {
+		std::ofstream logFile;
+		std::vector<std::string> jobFiles;
+		for (int i = 1; i < argc; ++i) {
+			if (std::string(argv[i]) == "--log" && i + 1 < argc)
+				logFile.open(argv[++i], std::ios::app);
+			else
+				jobFiles.push_back(argv[i]);
+		}
+		HMT::JobRunner<prec_t> runner(logFile.is_open() ? logFile : cout);
+		bool isQueued = true;
+		for (const std::string& path : jobFiles)
+			isQueued = runner.enqueue(path) && isQueued;
+		return runner.run() == 0 && isQueued ? 0 : 1;
+	}
+
 	cout << std::nounitbuf;
 	cout << std::setprecision(4) << std::fixed << std::boolalpha;
 	cout << "############################ HMT Assignment ##########################" << endl
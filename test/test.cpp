@@ -26,19 +26,31 @@ SOFTWARE.
 #include <iomanip>
 #include <cstdlib>
 #include <cstdint>
+#include <cstddef>
 #include <chrono>
 #include <thread>
 #include <atomic>
+#include <string>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <cmath>
+#include <sys/stat.h>
 
 #include "../header/Nodes.h"
+#include "../header/Batch.h"
+#include "../header/ResultWriter.h"
+#include "../header/JobRunner.h"
+#include "../header/Telemetry.h"
+#include "../header/Refinement.h"
+#include "../header/FixedNodes.h"
+#include "../header/AsyncSolver.h"
 
 using std::cout;	using std::endl;
 using std::clog;
 using std::cin;
 using std::make_pair;
 
-using prec_t = long double;
-
 namespace test
 {
 
@@ -57,7 +69,7 @@ public:
 			T tempNorth, T tempEast, T tempSouth, T tempWest,
 			T epsilon, bool canUseThreadsChoice): _epsilon(epsilon), _nodeX(nodeX), _nodeY(nodeY)
 	{
-		this->_nodes = HMT::Nodes<prec_t>(nodeX, nodeY);
+		this->_nodes = HMT::Nodes<T>(nodeX, nodeY);
 		this->_nodes.setWallTemp(tempNorth, tempEast, tempSouth, tempWest);
 		this->_nodes.canUseThreads(canUseThreadsChoice);
 		clog << "############### test::NodesWithoutHeatSrc [" << typeid(*this).name() << "] ########" << endl;
@@ -96,7 +108,7 @@ public:
 			const std::vector<std::pair<std::pair<uint64_t, uint64_t>, T>>& tempHeatSrc): _epsilon(epsilon),
 				_nodeX(nodeX), _nodeY(nodeY)
 	{
-		this->_nodes = HMT::Nodes<prec_t>(nodeX, nodeY);
+		this->_nodes = HMT::Nodes<T>(nodeX, nodeY);
 		this->_nodes.setWallTemp(tempNorth, tempEast, tempSouth, tempWest);
 		this->_nodes.canUseThreads(canUseThreadsChoice);
 		for (const auto& i : tempHeatSrc) {
@@ -128,4 +140,1616 @@ private:
 	uint64_t _nodeX, _nodeY;
 };
 
+template<typename T>
+class NodesThreadedMatchesSerial: public IUnitTest
+{
+public:
+	NodesThreadedMatchesSerial(uint64_t nodeX, uint64_t nodeY,
+			T tempNorth, T tempEast, T tempSouth, T tempWest,
+			T epsilon, unsigned int threadCnt,
+			const std::vector<std::pair<std::pair<uint64_t, uint64_t>, T>>& tempHeatSrc): _epsilon(epsilon),
+				_nodeX(nodeX), _nodeY(nodeY)
+	{
+		this->_serial = HMT::Nodes<T>(nodeX, nodeY);
+		this->_serial.setWallTemp(tempNorth, tempEast, tempSouth, tempWest);
+		this->_serial.canUseThreads(false);
+		this->_threaded = HMT::Nodes<T>(nodeX, nodeY);
+		this->_threaded.setWallTemp(tempNorth, tempEast, tempSouth, tempWest);
+		this->_threaded.canUseThreads(true);
+		this->_threaded.setThreadCount(threadCnt);
+		for (const auto& i : tempHeatSrc) {
+			this->_serial.setHeatSource(i.first.first, i.first.second, i.second);
+			this->_threaded.setHeatSource(i.first.first, i.first.second, i.second);
+		}
+		clog << "############### test::NodesThreadedMatchesSerial [" << typeid(*this).name() << "] ########" << endl;
+		clog << "HMT::Nodes objs created..." << endl;
+	}
+	virtual ~NodesThreadedMatchesSerial() = default;
+
+	virtual void test(void) override
+	{
+		this->_serial.calculate(this->_epsilon);
+		this->_threaded.calculate(this->_epsilon);
+
+		bool identical = this->_serial.getItterCount() == this->_threaded.getItterCount();
+		for (uint64_t i = 0; i < this->_nodeY; ++i)
+			for (uint64_t j = 0; j < this->_nodeX; ++j)
+				identical = identical && this->_serial.getTemp(j, i) == this->_threaded.getTemp(j, i);
+
+		clog << std::boolalpha;
+		clog << "threads: " << this->_threaded.getThreadCount() << endl
+			 << "no of itterations (serial / threaded): " << this->_serial.getItterCount()
+			 << " / " << this->_threaded.getItterCount() << endl
+			 << "bitwise identical: " << identical << endl
+			 << "################################################################################" << endl
+			 << endl;
+	}
+
+private:
+	HMT::Nodes<T> _serial, _threaded;
+	prec_t _epsilon;
+	uint64_t _nodeX, _nodeY;
+};
+
+template<typename T>
+class NodesSolverModes: public IUnitTest
+{
+public:
+	NodesSolverModes(uint64_t nodeX, uint64_t nodeY,
+			T tempNorth, T tempEast, T tempSouth, T tempWest,
+			T epsilon, bool canUseThreadsChoice,
+			const std::vector<std::pair<std::pair<uint64_t, uint64_t>, T>>& tempHeatSrc): _epsilon(epsilon),
+				_nodeX(nodeX), _nodeY(nodeY)
+	{
+		for (const HMT::SolverMode mode : {HMT::SolverMode::Jacobi, HMT::SolverMode::RedBlackSOR,
+				HMT::SolverMode::Multigrid, HMT::SolverMode::ConjugateGradient, HMT::SolverMode::TiledJacobi,
+				HMT::SolverMode::MixedPrecision, HMT::SolverMode::ADI, HMT::SolverMode::InPlace,
+				HMT::SolverMode::OutOfCore}) {
+			HMT::Nodes<T> nodes(nodeX, nodeY);
+			nodes.setWallTemp(tempNorth, tempEast, tempSouth, tempWest);
+			nodes.canUseThreads(canUseThreadsChoice);
+			nodes.setSolverMode(mode);
+			for (const auto& i : tempHeatSrc) {
+				nodes.setHeatSource(i.first.first, i.first.second, i.second);
+			}
+			this->_nodes.push_back(std::move(nodes));
+		}
+		clog << "############### test::NodesSolverModes [" << typeid(*this).name() << "] ########" << endl;
+		clog << "HMT::Nodes objs created..." << endl;
+	}
+	virtual ~NodesSolverModes() = default;
+
+	virtual void test(void) override
+	{
+		const char* names[] = {"Jacobi", "RedBlackSOR", "Multigrid", "ConjugateGradient", "TiledJacobi", "MixedPrecision",
+			"ADI", "InPlace", "OutOfCore"};
+		clog << std::setprecision(4) << std::fixed;
+		for (uint64_t m = 0; m < this->_nodes.size(); ++m) {
+			HMT::Nodes<T>& nodes = this->_nodes[m];
+			nodes.calculate(this->_epsilon);
+
+			// deviation from the reference (first) mode
+			prec_t deviation = 0;
+			for (uint64_t i = 0; i < this->_nodeY; ++i)
+				for (uint64_t j = 0; j < this->_nodeX; ++j)
+					deviation = std::max<prec_t>(deviation,
+						std::fabs(nodes.getTemp(j, i) - this->_nodes[0].getTemp(j, i)));
+
+			clog << names[m] << ": " << endl
+				 << "  no of itterations: " << nodes.getItterCount() << endl
+				 << "  time taken: " << nodes.getDuration().count() << "ns" << endl
+				 << "  peak memory: " << nodes.getMemoryFootprint().peakBytes << " bytes" << endl
+				 << "  max deviation from " << names[0] << ": " << std::scientific << deviation << std::fixed << endl;
+		}
+		clog << "relaxation factor: " << this->_nodes[1].getRelaxation() << endl
+			 << "################################################################################" << endl
+			 << endl;
+	}
+
+private:
+	std::vector<HMT::Nodes<T>> _nodes;
+	prec_t _epsilon;
+	uint64_t _nodeX, _nodeY;
+};
+
+template<typename T>
+class NodesInPlace: public IUnitTest
+{
+public:
+	NodesInPlace(uint64_t nodeX, uint64_t nodeY,
+			T tempNorth, T tempEast, T tempSouth, T tempWest,
+			T epsilon, unsigned int threadCnt,
+			const std::vector<std::pair<std::pair<uint64_t, uint64_t>, T>>& tempHeatSrc): _epsilon(epsilon),
+				_nodeX(nodeX), _nodeY(nodeY), _threadCnt(threadCnt)
+	{
+		this->_nodes = HMT::Nodes<T>(nodeX, nodeY);
+		this->_nodes.setWallTemp(tempNorth, tempEast, tempSouth, tempWest);
+		for (const auto& i : tempHeatSrc) {
+			this->_nodes.setHeatSource(i.first.first, i.first.second, i.second);
+		}
+		clog << "############### test::NodesInPlace [" << typeid(*this).name() << "] ########" << endl;
+		clog << "HMT::Nodes objs created..." << endl;
+	}
+	virtual ~NodesInPlace() = default;
+
+	virtual void test(void) override
+	{
+		clog << std::boolalpha;
+		HMT::ConvergencePolicy l2;
+		l2.norm = HMT::Norm::L2;
+		l2.checkEvery = 4;
+		for (const HMT::ConvergencePolicy& policy : {HMT::ConvergencePolicy(), l2}) {
+			for (const unsigned int threadCnt : {1u, this->_threadCnt}) {
+				HMT::Nodes<T> jacobi = this->_nodes, inPlace = this->_nodes;
+				for (HMT::Nodes<T>* nodes : {&jacobi, &inPlace}) {
+					nodes->setConvergencePolicy(policy);
+					nodes->canUseThreads(threadCnt > 1);
+					nodes->setThreadCount(threadCnt);
+				}
+				inPlace.setSolverMode(HMT::SolverMode::InPlace);
+				jacobi.calculate(this->_epsilon);
+				inPlace.calculate(this->_epsilon);
+				bool isSame = jacobi.getItterCount() == inPlace.getItterCount() &&
+					jacobi.getResidualHistory() == inPlace.getResidualHistory();
+				for (uint64_t i = 0; i < this->_nodeY && isSame; ++i)
+					for (uint64_t j = 0; j < this->_nodeX && isSame; ++j)
+						isSame = jacobi.getTemp(j, i) == inPlace.getTemp(j, i);
+				const HMT::MemoryFootprint before = jacobi.getMemoryFootprint(), after = inPlace.getMemoryFootprint();
+				clog << (policy.norm == HMT::Norm::L2 ? "l2, checked every 4" : "linf") << ", x" << threadCnt
+					 << ": " << inPlace.getItterCount() << " itterations, bitwise same as Jacobi: " << isSame << endl
+					 << "  peak bytes Jacobi / InPlace: " << before.peakBytes << " / " << after.peakBytes
+					 << " (" << std::setprecision(2) << static_cast<double>(before.peakBytes) / after.peakBytes
+					 << "x), InPlace scratch " << after.scratchBytes << std::setprecision(4) << endl;
+			}
+		}
+		// a second solve after an edit starts from the first one, as Jacobi does
+		HMT::Nodes<T> resolved = this->_nodes;
+		resolved.setSolverMode(HMT::SolverMode::InPlace);
+		resolved.calculate(this->_epsilon);
+		resolved.setWallTemp(400, 100, 100, 100);
+		resolved.calculate(this->_epsilon);
+		HMT::Nodes<T> reference = this->_nodes;
+		reference.setWallTemp(400, 100, 100, 100);
+		reference.calculate(this->_epsilon);
+		clog << "re-solved after an edit, same as Jacobi: " << (resolved.getTemp(this->_nodeX / 2, this->_nodeY / 2) ==
+			reference.getTemp(this->_nodeX / 2, this->_nodeY / 2)) << endl
+			 << "################################################################################" << endl
+			 << endl;
+	}
+
+private:
+	HMT::Nodes<T> _nodes;
+	prec_t _epsilon;
+	uint64_t _nodeX, _nodeY;
+	unsigned int _threadCnt;
+};
+
+template<typename T>
+class NodesOutOfCore: public IUnitTest
+{
+public:
+	NodesOutOfCore(uint64_t nodeX, uint64_t nodeY,
+			T tempNorth, T tempEast, T tempSouth, T tempWest,
+			T epsilon, const std::string& storePath,
+			const std::vector<std::pair<std::pair<uint64_t, uint64_t>, T>>& tempHeatSrc): _epsilon(epsilon),
+				_nodeX(nodeX), _nodeY(nodeY), _storePath(storePath)
+	{
+		this->_nodes = HMT::Nodes<T>(nodeX, nodeY);
+		this->_nodes.setWallTemp(tempNorth, tempEast, tempSouth, tempWest);
+		for (const auto& i : tempHeatSrc) {
+			this->_nodes.setHeatSource(i.first.first, i.first.second, i.second);
+		}
+		clog << "############### test::NodesOutOfCore [" << typeid(*this).name() << "] ########" << endl;
+		clog << "HMT::Nodes objs created..." << endl;
+	}
+	virtual ~NodesOutOfCore() = default;
+
+	virtual void test(void) override
+	{
+		clog << std::boolalpha;
+		HMT::Nodes<T> jacobi = this->_nodes;
+		jacobi.calculate(this->_epsilon);
+		// one band per row, more sweeps per load than rows per band, and the default band
+		const std::vector<std::pair<uint64_t, unsigned int>> shapes = {{1, 1}, {5, 3}, {3, 7}, {0, 4}};
+		for (const auto& shape : shapes) {
+			HMT::Nodes<T> streamed = this->_nodes;
+			streamed.setSolverMode(HMT::SolverMode::OutOfCore);
+			streamed.setStreaming(shape.first == 1 ? this->_storePath : "", shape.first, shape.second);
+			streamed.calculate(this->_epsilon);
+			const HMT::StreamStats io = streamed.getStreamStats();
+			clog << "rows " << shape.first << ", steps " << shape.second << ": " << streamed.getItterCount()
+				 << " itterations, " << io.passes << " passes, bitwise same as Jacobi: " << this->isSame(jacobi, streamed)
+				 << ", converged: " << streamed.hasConverged() << endl
+				 << "  read " << (io.bytesRead >> 10) << " KB at " << this->megabytesPerSecond(io.bytesRead, io.readTime)
+				 << " MB/s, wrote " << (io.bytesWritten >> 10) << " KB at "
+				 << this->megabytesPerSecond(io.bytesWritten, io.writeTime) << " MB/s" << endl
+				 << "  " << io.passTime.count() / 1000.0 / streamed.getItterCount() << " us per sweep, "
+				 << io.stallTime.count() / 1000 << " us waiting on a band" << endl;
+		}
+		// the named store goes with the solve
+		struct stat info;
+		clog << "store removed: " << (::stat(this->_storePath.c_str(), &info) != 0) << endl;
+
+		// a sweep budget that ends inside a pass stops on the same sweep as Jacobi
+		HMT::ConvergencePolicy budget;
+		budget.maxItterations = 50;
+		HMT::Nodes<T> jacobiBudget = this->_nodes, streamedBudget = this->_nodes;
+		jacobiBudget.setConvergencePolicy(budget);
+		streamedBudget.setConvergencePolicy(budget);
+		streamedBudget.setSolverMode(HMT::SolverMode::OutOfCore);
+		streamedBudget.setStreaming("", 4, 8);
+		jacobiBudget.calculate(this->_epsilon);
+		streamedBudget.calculate(this->_epsilon);
+		clog << "budget of 50: " << streamedBudget.getItterCount() << " itterations, converged: "
+			 << streamedBudget.hasConverged() << ", bitwise same as Jacobi: " << this->isSame(jacobiBudget, streamedBudget)
+			 << endl
+			 << "################################################################################" << endl
+			 << endl;
+	}
+
+private:
+	bool isSame(const HMT::Nodes<T>& lhs, const HMT::Nodes<T>& rhs) const
+	{
+		bool isSame = lhs.getItterCount() == rhs.getItterCount() &&
+			lhs.getResidualHistory() == rhs.getResidualHistory();
+		for (uint64_t i = 0; i < this->_nodeY && isSame; ++i)
+			for (uint64_t j = 0; j < this->_nodeX && isSame; ++j)
+				isSame = lhs.getTemp(j, i) == rhs.getTemp(j, i);
+		return isSame;
+	}
+
+	double megabytesPerSecond(const uint64_t& bytes, const std::chrono::nanoseconds& time) const
+	{
+		return time.count() > 0 ? bytes * 1e3 / time.count() : 0;
+	}
+
+	HMT::Nodes<T> _nodes;
+	prec_t _epsilon;
+	uint64_t _nodeX, _nodeY;
+	std::string _storePath;
+};
+
+template<typename T>
+class NodesStoreBacked: public IUnitTest
+{
+public:
+	NodesStoreBacked(uint64_t nodeX, uint64_t nodeY,
+			T tempNorth, T tempEast, T tempSouth, T tempWest,
+			T epsilon, uint64_t maxItterations, uint64_t memoryCap, const std::string& resultPath,
+			const std::vector<std::pair<std::pair<uint64_t, uint64_t>, T>>& tempHeatSrc): _epsilon(epsilon),
+				_nodeX(nodeX), _nodeY(nodeY), _memoryCap(memoryCap), _resultPath(resultPath)
+	{
+		// the same edits on a plate in memory and on one that only exists in its store,
+		// a wall and an interior source set and removed again among them
+		this->_nodes = HMT::Nodes<T>(nodeX, nodeY);
+		this->_backed = HMT::Nodes<T>(nodeX, nodeY, "");
+		for (HMT::Nodes<T>* nodes : {&this->_nodes, &this->_backed}) {
+			nodes->setWallTemp(tempNorth, tempEast, tempSouth, tempWest);
+			for (const auto& i : tempHeatSrc) {
+				nodes->setHeatSource(i.first.first, i.first.second, i.second);
+			}
+			nodes->setHeatSource(0, nodeY / 2, 1000);
+			nodes->setHeatSource(nodeX / 2, nodeY / 3, 1000);
+			nodes->removeHeatSource(0, nodeY / 2);
+			nodes->removeHeatSource(nodeX / 2, nodeY / 3);
+			HMT::ConvergencePolicy budget;
+			budget.maxItterations = maxItterations;
+			nodes->setConvergencePolicy(budget);
+			nodes->setWarmStart(true);
+		}
+		this->_backed.setStreaming("", 0, 4, memoryCap);
+		clog << "############### test::NodesStoreBacked [" << typeid(*this).name() << "] ########" << endl;
+		clog << "HMT::Nodes objs created..." << endl;
+	}
+	virtual ~NodesStoreBacked() = default;
+
+	virtual void test(void) override
+	{
+		clog << std::boolalpha;
+		this->_nodes.calculate(this->_epsilon);
+		this->_backed.calculate(this->_epsilon);
+		const HMT::MemoryFootprint footprint = this->_backed.getMemoryFootprint();
+		clog << "grid " << (this->_nodeX * this->_nodeY * sizeof(T) >> 10) << " KB under a cap of "
+			 << (this->_memoryCap >> 10) << " KB: held " << (footprint.gridBytes + footprint.maskBytes)
+			 << " bytes, peak " << (footprint.peakBytes >> 10) << " KB, within the cap: "
+			 << (footprint.peakBytes <= this->_memoryCap) << endl
+			 << "  " << this->_backed.getItterCount() << " itterations in " << this->_backed.getStreamStats().passes
+			 << " passes, bitwise same as Jacobi in memory: " << this->isSame() << endl;
+
+		// an edit after a solve lands in whichever generation the solve ended on
+		this->_nodes.setHeatSource(this->_nodeX / 4, this->_nodeY / 2, -500);
+		this->_backed.setHeatSource(this->_nodeX / 4, this->_nodeY / 2, -500);
+		this->_nodes.calculate(this->_epsilon);
+		this->_backed.calculate(this->_epsilon);
+		clog << "warm re-solve after an edit, bitwise same as Jacobi in memory: " << this->isSame() << endl;
+
+		// CSV straight from the store, row chunk by row chunk
+		const std::string memoryPath = this->_resultPath + ".memory";
+		const bool isWritten = this->_backed.writeResult(this->_resultPath, HMT::ResultFormat::Csv, 6) &&
+			this->_nodes.writeResult(memoryPath, HMT::ResultFormat::Csv, 6);
+		clog << "CSV from the store identical to the one from memory: "
+			 << (isWritten && this->readFile(this->_resultPath) == this->readFile(memoryPath)) << endl
+			 << "################################################################################" << endl
+			 << endl;
+		std::remove(this->_resultPath.c_str());
+		std::remove(memoryPath.c_str());
+	}
+
+private:
+	bool isSame(void) const
+	{
+		bool isSame = this->_nodes.getItterCount() == this->_backed.getItterCount() &&
+			this->_nodes.getResidualHistory() == this->_backed.getResidualHistory();
+		for (uint64_t i = 0; i < this->_nodeY && isSame; ++i)
+			for (uint64_t j = 0; j < this->_nodeX && isSame; ++j)
+				isSame = this->_nodes.getTemp(j, i) == this->_backed.getTemp(j, i);
+		return isSame;
+	}
+
+	std::string readFile(const std::string& path) const
+	{
+		std::ifstream file(path, std::ios::binary);
+		std::stringstream contents;
+		contents << file.rdbuf();
+		return contents.str();
+	}
+
+	HMT::Nodes<T> _nodes, _backed;
+	prec_t _epsilon;
+	uint64_t _nodeX, _nodeY, _memoryCap;
+	std::string _resultPath;
+};
+
+template<typename T>
+class NodesADI: public IUnitTest
+{
+public:
+	NodesADI(uint64_t nodeX, uint64_t nodeY,
+			T tempNorth, T tempEast, T tempSouth, T tempWest,
+			T epsilon, unsigned int threadCnt,
+			const std::vector<std::pair<std::pair<uint64_t, uint64_t>, T>>& tempHeatSrc): _epsilon(epsilon),
+				_nodeX(nodeX), _nodeY(nodeY)
+	{
+		HMT::Nodes<T> nodes(nodeX, nodeY);
+		nodes.setWallTemp(tempNorth, tempEast, tempSouth, tempWest);
+		for (const auto& i : tempHeatSrc) {
+			nodes.setHeatSource(i.first.first, i.first.second, i.second);
+		}
+		nodes.setThreadCount(threadCnt);
+		for (const HMT::SolverMode mode : {HMT::SolverMode::Jacobi, HMT::SolverMode::RedBlackSOR,
+				HMT::SolverMode::ADI, HMT::SolverMode::ADI}) {
+			nodes.setSolverMode(mode);
+			this->_nodes.push_back(nodes);
+		}
+		// the last one runs the same line solves on threadCnt threads
+		this->_nodes.back().canUseThreads(true);
+		clog << "############### test::NodesADI [" << typeid(*this).name() << "] ########" << endl;
+		clog << "HMT::Nodes objs created..." << endl;
+	}
+	virtual ~NodesADI() = default;
+
+	virtual void test(void) override
+	{
+		const char* names[] = {"Jacobi", "RedBlackSOR", "ADI", "ADI (threads)"};
+		clog << std::boolalpha;
+		for (uint64_t m = 0; m < this->_nodes.size(); ++m) {
+			HMT::Nodes<T>& nodes = this->_nodes[m];
+			nodes.calculate(this->_epsilon);
+			prec_t deviation = 0;
+			for (uint64_t i = 0; i < this->_nodeY; ++i)
+				for (uint64_t j = 0; j < this->_nodeX; ++j)
+					deviation = std::max<prec_t>(deviation,
+						std::fabs(nodes.getTemp(j, i) - this->_nodes[0].getTemp(j, i)));
+			clog << names[m] << " on " << this->_nodeX << "x" << this->_nodeY << ": "
+				 << nodes.getItterCount() << " itterations, " << nodes.getDuration().count() / 1000000 << " ms, "
+				 << "max deviation from Jacobi " << std::scientific << deviation << std::fixed << endl;
+		}
+		bool identical = this->_nodes[2].getItterCount() == this->_nodes[3].getItterCount();
+		for (uint64_t i = 0; identical && i < this->_nodeY; ++i)
+			for (uint64_t j = 0; j < this->_nodeX; ++j)
+				identical = identical && this->_nodes[2].getTemp(j, i) == this->_nodes[3].getTemp(j, i);
+		clog << "threaded ADI bitwise identical to serial: " << identical << endl
+			 << "################################################################################" << endl
+			 << endl;
+	}
+
+private:
+	std::vector<HMT::Nodes<T>> _nodes;
+	prec_t _epsilon;
+	uint64_t _nodeX, _nodeY;
+};
+
+template<typename T, uint64_t NX, uint64_t NY>
+class FixedNodesMatchesNodes: public IUnitTest
+{
+public:
+	FixedNodesMatchesNodes(T tempNorth, T tempEast, T tempSouth, T tempWest,
+			T epsilon, uint64_t plateCnt,
+			const std::vector<std::pair<std::pair<uint64_t, uint64_t>, T>>& tempHeatSrc): _epsilon(epsilon),
+				_tempNorth(tempNorth), _tempEast(tempEast), _tempSouth(tempSouth), _tempWest(tempWest),
+				_plateCnt(plateCnt), _heatSrc(tempHeatSrc)
+	{
+		clog << "############### test::FixedNodesMatchesNodes [" << typeid(*this).name() << "] ########" << endl;
+	}
+	virtual ~FixedNodesMatchesNodes() = default;
+
+	virtual void test(void) override
+	{
+		clog << std::boolalpha;
+		HMT::Nodes<T> reference(NX, NY);
+		HMT::FixedNodes<T, NX, NY> fixed;
+		this->setUp(reference);
+		this->setUp(fixed);
+		reference.calculate(this->_epsilon);
+		fixed.calculate(this->_epsilon);
+		bool identical = reference.getItterCount() == fixed.getItterCount();
+		for (uint64_t i = 0; identical && i < NY; ++i)
+			for (uint64_t j = 0; j < NX; ++j)
+				identical = identical && reference.getTemp(j, i) == fixed.getTemp(j, i);
+
+		// a fresh plate per solve, the way a request handler would use them
+		T checksum = 0;
+		const auto nodesStart = std::chrono::high_resolution_clock::now();
+		for (uint64_t p = 0; p < this->_plateCnt; ++p) {
+			HMT::Nodes<T> nodes(NX, NY);
+			this->setUp(nodes);
+			nodes.calculate(this->_epsilon);
+			checksum += nodes.getTemp(NX / 2, NY / 2);
+		}
+		const std::chrono::duration<double, std::micro> nodesTime = std::chrono::high_resolution_clock::now() - nodesStart;
+		const auto fixedStart = std::chrono::high_resolution_clock::now();
+		for (uint64_t p = 0; p < this->_plateCnt; ++p) {
+			HMT::FixedNodes<T, NX, NY> plate;
+			this->setUp(plate);
+			plate.calculate(this->_epsilon);
+			checksum -= plate.getTemp(NX / 2, NY / 2);
+		}
+		const std::chrono::duration<double, std::micro> fixedTime = std::chrono::high_resolution_clock::now() - fixedStart;
+
+		clog << NX << "x" << NY << ", " << fixed.getItterCount() << " itterations" << endl
+			 << "  bitwise identical to Nodes: " << identical << " (checksum " << checksum << ")" << endl
+			 << "  per plate (Nodes / FixedNodes): " << std::setprecision(1) << nodesTime.count() / this->_plateCnt
+			 << " / " << fixedTime.count() / this->_plateCnt << " us" << std::setprecision(4) << endl
+			 << "  object size: " << sizeof(HMT::FixedNodes<T, NX, NY>) << " bytes" << endl
+			 << "################################################################################" << endl
+			 << endl;
+	}
+
+private:
+	template<typename P>
+	void setUp(P& plate) const
+	{
+		plate.setWallTemp(this->_tempNorth, this->_tempEast, this->_tempSouth, this->_tempWest);
+		for (const auto& i : this->_heatSrc)
+			plate.setHeatSource(i.first.first, i.first.second, i.second);
+	}
+
+	prec_t _epsilon;
+	T _tempNorth, _tempEast, _tempSouth, _tempWest;
+	uint64_t _plateCnt;
+	std::vector<std::pair<std::pair<uint64_t, uint64_t>, T>> _heatSrc;
+};
+
+template<typename T>
+class NodesSimdMatchesScalar: public IUnitTest
+{
+public:
+	NodesSimdMatchesScalar(uint64_t nodeX, uint64_t nodeY,
+			T tempNorth, T tempEast, T tempSouth, T tempWest,
+			T epsilon,
+			const std::vector<std::pair<std::pair<uint64_t, uint64_t>, T>>& tempHeatSrc): _epsilon(epsilon),
+				_nodeX(nodeX), _nodeY(nodeY)
+	{
+		this->_nodes = HMT::Nodes<T>(nodeX, nodeY);
+		this->_nodes.setWallTemp(tempNorth, tempEast, tempSouth, tempWest);
+		for (const auto& i : tempHeatSrc) {
+			this->_nodes.setHeatSource(i.first.first, i.first.second, i.second);
+		}
+		clog << "############### test::NodesSimdMatchesScalar [" << typeid(*this).name() << "] ########" << endl;
+		clog << "HMT::Nodes obj created..." << endl;
+	}
+	virtual ~NodesSimdMatchesScalar() = default;
+
+	virtual void test(void) override
+	{
+		const HMT::SimdIsa detected = HMT::Kernels::detectIsa();
+		HMT::Kernels::setIsa(HMT::SimdIsa::Scalar);
+		HMT::Nodes<T> reference = this->_nodes;
+		reference.calculate(this->_epsilon);
+
+		clog << std::boolalpha;
+		for (const HMT::SimdIsa isa : {HMT::SimdIsa::SSE41, HMT::SimdIsa::AVX2, HMT::SimdIsa::AVX512}) {
+			if (detected < isa)
+				continue;
+			HMT::Kernels::setIsa(isa);
+			HMT::Nodes<T> nodes = this->_nodes;
+			nodes.calculate(this->_epsilon);
+
+			bool identical = reference.getItterCount() == nodes.getItterCount();
+			for (uint64_t i = 0; i < this->_nodeY; ++i)
+				for (uint64_t j = 0; j < this->_nodeX; ++j)
+					identical = identical && reference.getTemp(j, i) == nodes.getTemp(j, i);
+			clog << HMT::Kernels::isaName(isa) << ": " << nodes.getItterCount() << " itterations, "
+				 << nodes.getDuration().count() << "ns (scalar: " << reference.getDuration().count() << "ns), "
+				 << "bitwise identical: " << identical << endl;
+		}
+		HMT::Kernels::setIsa(detected);
+		clog << "################################################################################" << endl
+			 << endl;
+	}
+
+private:
+	HMT::Nodes<T> _nodes;
+	prec_t _epsilon;
+	uint64_t _nodeX, _nodeY;
+};
+
+template<typename T>
+class NodesTiledMatchesJacobi: public IUnitTest
+{
+public:
+	NodesTiledMatchesJacobi(uint64_t nodeX, uint64_t nodeY,
+			T tempNorth, T tempEast, T tempSouth, T tempWest,
+			T epsilon, const HMT::TileShape& shape, unsigned int threadCnt,
+			const std::vector<std::pair<std::pair<uint64_t, uint64_t>, T>>& tempHeatSrc): _epsilon(epsilon),
+				_nodeX(nodeX), _nodeY(nodeY)
+	{
+		this->_jacobi = HMT::Nodes<T>(nodeX, nodeY);
+		this->_jacobi.setWallTemp(tempNorth, tempEast, tempSouth, tempWest);
+		for (const auto& i : tempHeatSrc) {
+			this->_jacobi.setHeatSource(i.first.first, i.first.second, i.second);
+		}
+		this->_tiled = this->_jacobi;
+		this->_tiled.setSolverMode(HMT::SolverMode::TiledJacobi);
+		this->_tiled.setTiling(shape);
+		this->_tiled.canUseThreads(threadCnt > 1);
+		this->_tiled.setThreadCount(threadCnt);
+		clog << "############### test::NodesTiledMatchesJacobi [" << typeid(*this).name() << "] ########" << endl;
+		clog << "HMT::Nodes objs created..." << endl;
+	}
+	virtual ~NodesTiledMatchesJacobi() = default;
+
+	virtual void test(void) override
+	{
+		this->_jacobi.calculate(this->_epsilon);
+		this->_tiled.calculate(this->_epsilon);
+
+		bool identical = this->_jacobi.getItterCount() == this->_tiled.getItterCount();
+		for (uint64_t i = 0; i < this->_nodeY; ++i)
+			for (uint64_t j = 0; j < this->_nodeX; ++j)
+				identical = identical && this->_jacobi.getTemp(j, i) == this->_tiled.getTemp(j, i);
+
+		// a budget that ends inside a block, with an epsilon never reached
+		HMT::ConvergencePolicy budget;
+		budget.maxItterations = 50;
+		HMT::Nodes<T> jacobiBudget = this->_jacobi, tiledBudget = this->_tiled;
+		jacobiBudget.setConvergencePolicy(budget);
+		tiledBudget.setConvergencePolicy(budget);
+		jacobiBudget.setWallTemp(400, 100, 100, 100);
+		tiledBudget.setWallTemp(400, 100, 100, 100);
+		jacobiBudget.calculate(0);
+		tiledBudget.calculate(0);
+		bool isBudgetSame = jacobiBudget.getItterCount() == tiledBudget.getItterCount() &&
+			!tiledBudget.hasConverged();
+		for (uint64_t i = 0; i < this->_nodeY; ++i)
+			for (uint64_t j = 0; j < this->_nodeX; ++j)
+				isBudgetSame = isBudgetSame && jacobiBudget.getTemp(j, i) == tiledBudget.getTemp(j, i);
+
+		// walls only, no interior to tile
+		HMT::Nodes<T> flat(this->_nodeX, 2);
+		flat.setSolverMode(HMT::SolverMode::TiledJacobi);
+		flat.setWallTemp(500, 100, 100, 100);
+		flat.calculate(this->_epsilon);
+
+		const HMT::TileShape shape = this->_tiled.getTiling();
+		clog << std::boolalpha;
+		clog << "tile: " << shape.rows << "x" << shape.cols << ", " << shape.steps << " steps" << endl
+			 << "no of itterations (jacobi / tiled): " << this->_jacobi.getItterCount()
+			 << " / " << this->_tiled.getItterCount() << endl
+			 << "bitwise identical: " << identical << endl
+			 << "budget of 50: " << tiledBudget.getItterCount() << " itterations, converged: "
+			 << tiledBudget.hasConverged() << ", bitwise same as Jacobi: " << isBudgetSame << endl
+			 << "no interior: " << flat.getItterCount() << " itterations" << endl
+			 << "################################################################################" << endl
+			 << endl;
+	}
+
+private:
+	HMT::Nodes<T> _jacobi, _tiled;
+	prec_t _epsilon;
+	uint64_t _nodeX, _nodeY;
+};
+
+template<typename T>
+class NodesMixedPrecision: public IUnitTest
+{
+public:
+	NodesMixedPrecision(uint64_t nodeX, uint64_t nodeY,
+			T tempNorth, T tempEast, T tempSouth, T tempWest,
+			T epsilon, const HMT::LowPrecision precision,
+			const std::vector<std::pair<std::pair<uint64_t, uint64_t>, T>>& tempHeatSrc): _epsilon(epsilon),
+				_nodeX(nodeX), _nodeY(nodeY)
+	{
+		this->_reference = HMT::Nodes<T>(nodeX, nodeY);
+		this->_reference.setWallTemp(tempNorth, tempEast, tempSouth, tempWest);
+		for (const auto& i : tempHeatSrc) {
+			this->_reference.setHeatSource(i.first.first, i.first.second, i.second);
+		}
+		this->_mixed = this->_reference;
+		this->_mixed.setSolverMode(HMT::SolverMode::MixedPrecision);
+		this->_mixed.setLowPrecision(precision);
+		clog << "############### test::NodesMixedPrecision [" << typeid(*this).name() << "] ########" << endl;
+		clog << "HMT::Nodes objs created..." << endl;
+	}
+	virtual ~NodesMixedPrecision() = default;
+
+	virtual void test(void) override
+	{
+		this->_reference.calculate(this->_epsilon);
+		this->_mixed.calculate(this->_epsilon);
+
+		prec_t deviation = 0;
+		for (uint64_t i = 0; i < this->_nodeY; ++i)
+			for (uint64_t j = 0; j < this->_nodeX; ++j)
+				deviation = std::max<prec_t>(deviation,
+					std::fabs(this->_mixed.getTemp(j, i) - this->_reference.getTemp(j, i)));
+
+		clog << "low precision: " << (this->_mixed.getLowPrecision() == HMT::LowPrecision::Float ? "float" : "double") << endl
+			 << "no of itterations (reference): " << this->_reference.getItterCount() << endl
+			 << "sweeps (low / high precision): " << this->_mixed.getLowPrecisionSweeps()
+			 << " / " << this->_mixed.getHighPrecisionSweeps() << endl
+			 << "max deviation from reference: " << std::scientific << deviation << std::fixed << endl
+			 << "################################################################################" << endl
+			 << endl;
+	}
+
+private:
+	HMT::Nodes<T> _reference, _mixed;
+	prec_t _epsilon;
+	uint64_t _nodeX, _nodeY;
+};
+
+template<typename T>
+class NodesConvergencePolicy: public IUnitTest
+{
+public:
+	NodesConvergencePolicy(uint64_t nodeX, uint64_t nodeY,
+			T tempNorth, T tempEast, T tempSouth, T tempWest,
+			T epsilon, unsigned int threadCnt,
+			const std::vector<std::pair<std::pair<uint64_t, uint64_t>, T>>& tempHeatSrc): _epsilon(epsilon),
+				_nodeX(nodeX), _nodeY(nodeY)
+	{
+		HMT::Nodes<T> nodes(nodeX, nodeY);
+		nodes.setWallTemp(tempNorth, tempEast, tempSouth, tempWest);
+		for (const auto& i : tempHeatSrc) {
+			nodes.setHeatSource(i.first.first, i.first.second, i.second);
+		}
+		HMT::ConvergencePolicy policy;
+		this->_nodes.push_back(nodes);
+		policy.checkEvery = 8;
+		nodes.setConvergencePolicy(policy);
+		this->_nodes.push_back(nodes);
+		nodes.canUseThreads(true);
+		nodes.setThreadCount(threadCnt);
+		this->_nodes.push_back(nodes);
+		nodes.canUseThreads(false);
+		policy.norm = HMT::Norm::L2;
+		nodes.setConvergencePolicy(policy);
+		this->_nodes.push_back(nodes);
+		policy.norm = HMT::Norm::Relative;
+		nodes.setConvergencePolicy(policy);
+		this->_nodes.push_back(nodes);
+		policy.norm = HMT::Norm::LInf;
+		policy.checkEvery = 16;
+		policy.maxItterations = 100;
+		nodes.setConvergencePolicy(policy);
+		this->_nodes.push_back(nodes);
+		clog << "############### test::NodesConvergencePolicy [" << typeid(*this).name() << "] ########" << endl;
+		clog << "HMT::Nodes objs created..." << endl;
+	}
+	virtual ~NodesConvergencePolicy() = default;
+
+	virtual void test(void) override
+	{
+		const char* names[] = {"LInf every sweep", "LInf every 8", "LInf every 8, threaded",
+			"L2 every 8", "Relative every 8", "LInf every 16, max 100"};
+		clog << std::boolalpha;
+		for (uint64_t m = 0; m < this->_nodes.size(); ++m) {
+			HMT::Nodes<T>& nodes = this->_nodes[m];
+			nodes.calculate(this->_epsilon);
+
+			prec_t deviation = 0;
+			for (uint64_t i = 0; i < this->_nodeY; ++i)
+				for (uint64_t j = 0; j < this->_nodeX; ++j)
+					deviation = std::max<prec_t>(deviation,
+						std::fabs(nodes.getTemp(j, i) - this->_nodes[0].getTemp(j, i)));
+
+			clog << names[m] << ": " << endl
+				 << "  no of itterations: " << nodes.getItterCount() << endl
+				 << "  checks: " << nodes.getResidualHistory().size() << endl
+				 << "  converged: " << nodes.hasConverged() << endl
+				 << "  max deviation from " << names[0] << ": " << std::scientific << deviation << std::fixed << endl;
+		}
+		clog << "################################################################################" << endl
+			 << endl;
+	}
+
+private:
+	std::vector<HMT::Nodes<T>> _nodes;
+	prec_t _epsilon;
+	uint64_t _nodeX, _nodeY;
+};
+
+template<typename T>
+class NodesCheckpointRestart: public IUnitTest
+{
+public:
+	NodesCheckpointRestart(uint64_t nodeX, uint64_t nodeY,
+			T tempNorth, T tempEast, T tempSouth, T tempWest,
+			T epsilon, const std::string& path, uint64_t killAfter,
+			const std::vector<std::pair<std::pair<uint64_t, uint64_t>, T>>& tempHeatSrc): _epsilon(epsilon),
+				_nodeX(nodeX), _nodeY(nodeY), _path(path), _killAfter(killAfter)
+	{
+		this->_reference = HMT::Nodes<T>(nodeX, nodeY);
+		this->_reference.setWallTemp(tempNorth, tempEast, tempSouth, tempWest);
+		for (const auto& i : tempHeatSrc) {
+			this->_reference.setHeatSource(i.first.first, i.first.second, i.second);
+		}
+		this->_killed = this->_reference;
+		HMT::ConvergencePolicy policy;
+		policy.maxItterations = killAfter;
+		this->_killed.setConvergencePolicy(policy);
+		this->_killed.setCheckpointing(path, killAfter / 2);
+		clog << "############### test::NodesCheckpointRestart [" << typeid(*this).name() << "] ########" << endl;
+		clog << "HMT::Nodes objs created..." << endl;
+	}
+	virtual ~NodesCheckpointRestart() = default;
+
+	virtual void test(void) override
+	{
+		this->_reference.calculate(this->_epsilon);
+		// the interrupted run leaves its last periodic checkpoint behind
+		this->_killed.calculate(this->_epsilon);
+
+		HMT::Nodes<T> restarted(3, 3);
+		const bool isLoaded = restarted.loadCheckpoint(this->_path);
+		restarted.canUseThreads(true);
+		restarted.setThreadCount(3);
+		restarted.calculate(this->_epsilon);
+		// sizes that wrap to 0 cells, and a plate too small to have an interior
+		bool isCorruptRejected = true;
+		for (const std::pair<uint64_t, uint64_t>& size : {make_pair(uint64_t(1) << 33, uint64_t(1) << 31),
+				make_pair(uint64_t(2), this->_nodeY)}) {
+			this->_killed.saveCheckpoint(this->_path);
+			std::fstream file(this->_path, std::ios::in | std::ios::out | std::ios::binary);
+			file.seekp(offsetof(HMT::CheckpointHeader, nodeX));
+			file.write(reinterpret_cast<const char*>(&size.first), sizeof(uint64_t));
+			file.write(reinterpret_cast<const char*>(&size.second), sizeof(uint64_t));
+			file.close();
+			HMT::Nodes<T> corrupt(3, 3);
+			isCorruptRejected = isCorruptRejected && !corrupt.loadCheckpoint(this->_path);
+		}
+		std::remove(this->_path.c_str());
+		const uint64_t restartedItterCnt = restarted.getItterCount();
+		bool identical = isLoaded && this->_reference.getItterCount() == restartedItterCnt;
+		for (uint64_t i = 0; identical && i < this->_nodeY; ++i)
+			for (uint64_t j = 0; j < this->_nodeX; ++j)
+				identical = identical && this->_reference.getTemp(j, i) == restarted.getTemp(j, i);
+
+		// the next solve counts from 0 again, in any mode
+		restarted.setSolverMode(HMT::SolverMode::RedBlackSOR);
+		restarted.calculate(this->_epsilon);
+		const bool isFreshCount = restarted.getItterCount() < restartedItterCnt &&
+			restarted.getResidualHistory().size() == restarted.getItterCount();
+
+		clog << std::boolalpha;
+		clog << "checkpoint loaded: " << isLoaded << endl
+			 << "interrupted after: " << this->_killed.getItterCount() << " (converged: "
+			 << this->_killed.hasConverged() << ")" << endl
+			 << "no of itterations (reference / restarted): " << this->_reference.getItterCount()
+			 << " / " << restartedItterCnt << endl
+			 << "bitwise identical: " << identical << endl
+			 << "corrupt sizes rejected: " << isCorruptRejected << endl
+			 << "RedBlackSOR re-solve: " << restarted.getItterCount() << " itterations, counted from 0: "
+			 << isFreshCount << endl
+			 << "################################################################################" << endl
+			 << endl;
+	}
+
+private:
+	HMT::Nodes<T> _reference, _killed;
+	prec_t _epsilon;
+	uint64_t _nodeX, _nodeY;
+	std::string _path;
+	uint64_t _killAfter;
+};
+
+template<typename T>
+class NodesWarmStart: public IUnitTest
+{
+public:
+	NodesWarmStart(uint64_t nodeX, uint64_t nodeY,
+			T tempNorth, T tempEast, T tempSouth, T tempWest,
+			T epsilon, const std::pair<uint64_t, uint64_t>& from, const std::pair<uint64_t, uint64_t>& to,
+			const std::vector<std::pair<std::pair<uint64_t, uint64_t>, T>>& tempHeatSrc): _epsilon(epsilon),
+				_nodeX(nodeX), _nodeY(nodeY), _from(from), _to(to)
+	{
+		this->_warm = HMT::Nodes<T>(nodeX, nodeY);
+		this->_warm.setWallTemp(tempNorth, tempEast, tempSouth, tempWest);
+		for (const auto& i : tempHeatSrc) {
+			this->_warm.setHeatSource(i.first.first, i.first.second, i.second);
+		}
+		this->_cold = this->_warm;
+		this->_warm.setWarmStart(true);
+		this->_warm.setPreSmoothing(2, 4);
+		clog << "############### test::NodesWarmStart [" << typeid(*this).name() << "] ########" << endl;
+		clog << "HMT::Nodes objs created..." << endl;
+	}
+	virtual ~NodesWarmStart() = default;
+
+	virtual void test(void) override
+	{
+		this->_warm.calculate(this->_epsilon);
+		const uint64_t firstItterCnt = this->_warm.getItterCount();
+
+		// move one heat source on both; only the warm one keeps its field
+		const T temp = this->_warm.getTemp(this->_from.first, this->_from.second);
+		for (HMT::Nodes<T>* nodes : {&this->_warm, &this->_cold}) {
+			nodes->removeHeatSource(this->_from.first, this->_from.second);
+			nodes->setHeatSource(this->_to.first, this->_to.second, temp);
+			nodes->calculate(this->_epsilon);
+		}
+
+		prec_t deviation = 0;
+		for (uint64_t i = 0; i < this->_nodeY; ++i)
+			for (uint64_t j = 0; j < this->_nodeX; ++j)
+				deviation = std::max<prec_t>(deviation,
+					std::fabs(this->_warm.getTemp(j, i) - this->_cold.getTemp(j, i)));
+
+		// sources on a wall and on a corner go back to the wall's own temperature
+		HMT::Nodes<T> walls = this->_cold;
+		const T north = walls.getTemp(1, 0), east = walls.getTemp(this->_nodeX - 1, 1);
+		walls.setHeatSource(this->_nodeX / 2, 0, 42);
+		walls.setHeatSource(this->_nodeX - 1, this->_nodeY / 2, 42);
+		walls.setHeatSource(this->_nodeX - 1, 0, 42);
+		walls.removeHeatSource(this->_nodeX / 2, 0);
+		walls.removeHeatSource(this->_nodeX - 1, this->_nodeY / 2);
+		walls.removeHeatSource(this->_nodeX - 1, 0);
+		walls.calculate(this->_epsilon);
+		const bool isWallRestored = walls.getTemp(this->_nodeX / 2, 0) == north &&
+			walls.getTemp(this->_nodeX - 1, this->_nodeY / 2) == east && walls.getTemp(this->_nodeX - 1, 0) == north;
+
+		clog << "no of itterations (first solve): " << firstItterCnt << endl
+			 << "no of itterations after the move (cold / warm): " << this->_cold.getItterCount()
+			 << " / " << this->_warm.getItterCount() << endl
+			 << "max deviation warm from cold: " << std::scientific << deviation << std::fixed << endl
+			 << "wall sources removed to the wall temperature: " << std::boolalpha << isWallRestored << endl
+			 << "################################################################################" << endl
+			 << endl;
+	}
+
+private:
+	HMT::Nodes<T> _warm, _cold;
+	prec_t _epsilon;
+	uint64_t _nodeX, _nodeY;
+	std::pair<uint64_t, uint64_t> _from, _to;
+};
+
+template<typename T>
+class BatchMatchesNodes: public IUnitTest
+{
+public:
+	BatchMatchesNodes(uint64_t nodeX, uint64_t nodeY, T epsilon, unsigned int threadCnt,
+			const std::vector<HMT::Scenario<T>>& scenarios): _epsilon(epsilon),
+				_nodeX(nodeX), _nodeY(nodeY), _threadCnt(threadCnt), _scenarios(scenarios)
+	{
+		for (const HMT::Scenario<T>& scenario : scenarios) {
+			HMT::Nodes<T> nodes(nodeX, nodeY);
+			nodes.setWallTemp(scenario.tempNorth, scenario.tempEast, scenario.tempSouth, scenario.tempWest);
+			for (const auto& i : scenario.heatSources) {
+				nodes.setHeatSource(i.first.first, i.first.second, i.second);
+			}
+			this->_nodes.push_back(std::move(nodes));
+		}
+		clog << "############### test::BatchMatchesNodes [" << typeid(*this).name() << "] ########" << endl;
+		clog << "HMT::Nodes objs created..." << endl;
+	}
+	virtual ~BatchMatchesNodes() = default;
+
+	virtual void test(void) override
+	{
+		for (HMT::Nodes<T>& nodes : this->_nodes)
+			nodes.calculate(this->_epsilon);
+
+		clog << std::boolalpha;
+		for (const bool interleaved : {false, true}) {
+			HMT::BatchSolver<T> batch(this->_nodeX, this->_nodeY);
+			batch.setThreadCount(this->_threadCnt);
+			batch.setInterleaved(interleaved);
+			batch.solve(this->_scenarios, this->_epsilon);
+
+			bool identical = batch.size() == this->_nodes.size();
+			for (uint64_t s = 0; identical && s < this->_nodes.size(); ++s) {
+				identical = identical && batch.getItterCount(s) == this->_nodes[s].getItterCount();
+				for (uint64_t i = 0; i < this->_nodeY; ++i)
+					for (uint64_t j = 0; j < this->_nodeX; ++j)
+						identical = identical && batch.getTemp(s, j, i) == this->_nodes[s].getTemp(j, i);
+			}
+			clog << "interleaved: " << interleaved << ", lanes: " << batch.getLaneCount()
+				 << ", steals: " << batch.getStealCount() << endl
+				 << "  time taken: " << batch.getDuration().count() << "ns" << endl
+				 << "  bitwise identical: " << identical << endl;
+		}
+		clog << "################################################################################" << endl
+			 << endl;
+	}
+
+private:
+	std::vector<HMT::Nodes<T>> _nodes;
+	prec_t _epsilon;
+	uint64_t _nodeX, _nodeY;
+	unsigned int _threadCnt;
+	std::vector<HMT::Scenario<T>> _scenarios;
+};
+
+template<typename T>
+class ResultWritersThroughput: public IUnitTest
+{
+public:
+	ResultWritersThroughput(uint64_t nodeX, uint64_t nodeY, unsigned int precision, const std::string& path):
+		_nodeX(nodeX), _nodeY(nodeY), _precision(precision), _path(path), _values(nodeX * nodeY)
+	{
+		// smooth field with a spread of magnitudes and signs, like a solved plate
+		for (uint64_t i = 0; i < nodeY; ++i)
+			for (uint64_t j = 0; j < nodeX; ++j)
+				this->_values[i * nodeX + j] = static_cast<T>(100 + 400 * std::sin(0.01 * j) * std::cos(0.013 * i));
+		clog << "############### test::ResultWritersThroughput [" << typeid(*this).name() << "] ########" << endl;
+		clog << "field of " << nodeX << "x" << nodeY << " created..." << endl;
+	}
+	virtual ~ResultWritersThroughput() = default;
+
+	virtual void test(void) override
+	{
+		clog << std::boolalpha << std::setprecision(1) << std::fixed;
+		{
+			// what operator<< used to do: one insertion per value and std::endl per row
+			const auto start = std::chrono::high_resolution_clock::now();
+			std::ofstream file(this->_path);
+			file << std::setprecision(this->_precision) << std::fixed;
+			for (uint64_t i = 0; i < this->_nodeY; ++i) {
+				for (uint64_t j = 0; j < this->_nodeX; ++j)
+					file << this->_values[i * this->_nodeX + j] << ", ";
+				file << endl;
+			}
+			file.close();
+			this->report("ostream + endl", start);
+		}
+		const std::pair<const char*, HMT::ResultFormat> formats[] = {
+			{"csv", HMT::ResultFormat::Csv}, {"raw", HMT::ResultFormat::Raw}, {"vtk", HMT::ResultFormat::Vtk}};
+		for (const auto& format : formats) {
+			const auto start = std::chrono::high_resolution_clock::now();
+			const bool isWritten = HMT::ResultWriter::write(this->_path, format.second, this->_nodeX, this->_nodeY,
+				this->_values.data(), this->_precision);
+			this->report(format.first, start);
+			if (format.second == HMT::ResultFormat::Raw)
+				clog << "  written: " << isWritten << ", read back identical: " << this->isRawIdentical() << endl;
+			else
+				clog << "  written: " << isWritten << endl;
+		}
+		std::remove(this->_path.c_str());
+
+		uint64_t mismatches = 0;
+		char fast[HMT::ResultWriter::maxFieldWidth], slow[HMT::ResultWriter::maxFieldWidth];
+		for (const T& value : this->_values) {
+			const uint64_t len = HMT::ResultWriter::formatFixed(value, this->_precision, fast);
+			std::snprintf(slow, sizeof(slow), "%.*Lf", this->_precision, static_cast<long double>(value));
+			mismatches += std::string(fast, len) != slow;
+			// past 18 decimals it is printf itself
+			const uint64_t longLen = HMT::ResultWriter::formatFixed(value, 24, fast);
+			std::snprintf(slow, sizeof(slow), "%.*Lf", 24, static_cast<long double>(value));
+			mismatches += std::string(fast, longLen) != slow;
+		}
+
+		// operator<< prints what one insertion per value would, whatever the stream flags
+		HMT::Nodes<T> plate(5, 4);
+		plate.setWallTemp(500, -100, 100, 100);
+		plate.calculate(0.001);
+		uint64_t streamMismatches = 0;
+		for (unsigned int variant = 0; variant < 5; ++variant) {
+			std::ostringstream viaNodes, perValue;
+			for (std::ostringstream* os : {&viaNodes, &perValue}) {
+				*os << std::fixed << std::setprecision(variant == 1 ? 20 : 4);
+				if (variant == 2)
+					*os << std::showpos;
+				if (variant == 4)
+					*os << std::showpoint << std::setprecision(0);
+			}
+			if (variant == 3)
+				viaNodes << std::setw(12);
+			viaNodes << plate;
+			for (uint64_t i = 0; i < 4; ++i) {
+				for (uint64_t j = 0; j < 5; ++j) {
+					if (variant == 3 && i == 0 && j == 0)
+						perValue << std::setw(12);
+					perValue << plate.getTemp(j, i) << ", ";
+				}
+				perValue << '\n';
+			}
+			streamMismatches += viaNodes.str() != perValue.str();
+		}
+		clog << "formatFixed digits differing from printf: " << mismatches << " of " << 2 * this->_values.size() << endl
+			 << "operator<< differing from per value insertion (plain, 20 digits, showpos, setw, showpoint): "
+			 << streamMismatches << " of 5" << endl
+			 << "################################################################################" << endl
+			 << endl;
+	}
+
+private:
+	void report(const char* name, const std::chrono::high_resolution_clock::time_point& start) const
+	{
+		const std::chrono::duration<double> taken = std::chrono::high_resolution_clock::now() - start;
+		struct stat info;
+		const double megabytes = ::stat(this->_path.c_str(), &info) == 0 ? info.st_size / 1048576.0 : 0;
+		clog << name << ": " << megabytes << "MB in " << taken.count() * 1000 << "ms, "
+			 << megabytes / taken.count() << "MB/s" << endl;
+	}
+
+	bool isRawIdentical(void) const
+	{
+		typedef typename HMT::ResultWriter::template Stored<T> Stored;
+		std::vector<Stored> readBack(this->_values.size());
+		std::ifstream file(this->_path, std::ios::binary);
+		file.read(reinterpret_cast<char*>(readBack.data()), readBack.size() * sizeof(Stored));
+		bool identical = static_cast<uint64_t>(file.gcount()) == readBack.size() * sizeof(Stored);
+		for (uint64_t k = 0; identical && k < readBack.size(); ++k)
+			identical = readBack[k] == static_cast<Stored>(this->_values[k]);
+		return identical;
+	}
+
+	uint64_t _nodeX, _nodeY;
+	unsigned int _precision;
+	std::string _path;
+	HMT::AlignedVector<T> _values;
+};
+
+template<typename T>
+class JobRunnerQueue: public IUnitTest
+{
+public:
+	JobRunnerQueue(const std::string& jobPath, const std::string& resultPath):
+		_jobPath(jobPath), _resultPath(resultPath)
+	{
+		// dX differs from dY, the interactive init used to size y with dX
+		std::ofstream file(jobPath);
+		file << "# shared by every job below\n"
+			 << "walls = 500 100 100 100\n"
+			 << "spacing = 10 5\n"
+			 << "epsilon = 1e-7\n"
+			 << "[job]\n"
+			 << "name = serial-jacobi\n"
+			 << "length = 120 150\n"
+			 << "heatSource = 2 2 300\n"
+			 << "[job]\n"
+			 << "name = threaded-sor\n"
+			 << "length = 120 150\n"
+			 << "heatSource = 2 2 300   # trailing comment\n"
+			 << "heatSource = 5 5 -1000\n"
+			 << "solver = sor\n"
+			 << "threads = 3\n"
+			 << "output = " << resultPath << "\n"
+			 << "format = raw\n"
+			 << "[job]\n"
+			 << "name = off-the-plate\n"
+			 << "length = 120 150\n"
+			 << "heatSource = 12 2 300\n";
+		clog << "############### test::JobRunnerQueue [" << typeid(*this).name() << "] ########" << endl;
+		clog << "job file written..." << endl;
+	}
+	virtual ~JobRunnerQueue() = default;
+
+	virtual void test(void) override
+	{
+		std::ostringstream log;
+		HMT::JobRunner<T> runner(log);
+		const bool isQueued = runner.enqueue(this->_jobPath);
+		const uint64_t queued = runner.size();
+		const uint64_t failCnt = runner.run();
+		std::remove(this->_jobPath.c_str());
+
+		// the same plate as the second job, solved directly
+		HMT::Nodes<T> reference(12, 30);
+		reference.setWallTemp(500, 100, 100, 100);
+		reference.setHeatSource(2, 2, 300);
+		reference.setHeatSource(5, 5, -1000);
+		reference.setSolverMode(HMT::SolverMode::RedBlackSOR);
+		reference.calculate(1e-7);
+		typedef typename HMT::ResultWriter::template Stored<T> Stored;
+		std::vector<Stored> written(12 * 30);
+		std::ifstream file(this->_resultPath, std::ios::binary);
+		file.read(reinterpret_cast<char*>(written.data()), written.size() * sizeof(Stored));
+		bool identical = static_cast<uint64_t>(file.gcount()) == written.size() * sizeof(Stored);
+		for (uint64_t i = 0; identical && i < 30; ++i)
+			for (uint64_t j = 0; j < 12; ++j)
+				identical = identical && written[i * 12 + j] == static_cast<Stored>(reference.getTemp(j, i));
+		file.close();
+		std::remove(this->_resultPath.c_str());
+
+		clog << std::boolalpha;
+		clog << "queued: " << isQueued << ", jobs: " << queued << ", not ok: " << failCnt << endl
+			 << "log:" << endl << log.str()
+			 << "written result identical to a direct solve: " << identical << endl
+			 << "################################################################################" << endl
+			 << endl;
+	}
+
+private:
+	std::string _jobPath, _resultPath;
+};
+
+template<typename T>
+class DistributedMatchesSerial: public IUnitTest
+{
+public:
+	DistributedMatchesSerial(uint64_t nodeX, uint64_t nodeY,
+			T tempNorth, T tempEast, T tempSouth, T tempWest,
+			T epsilon, const std::vector<unsigned int>& processCnts,
+			const std::vector<std::pair<std::pair<uint64_t, uint64_t>, T>>& tempHeatSrc): _epsilon(epsilon),
+				_nodeX(nodeX), _nodeY(nodeY), _processCnts(processCnts)
+	{
+		this->_serial = HMT::Nodes<T>(nodeX, nodeY);
+		this->_serial.setWallTemp(tempNorth, tempEast, tempSouth, tempWest);
+		for (const auto& i : tempHeatSrc) {
+			this->_serial.setHeatSource(i.first.first, i.first.second, i.second);
+		}
+		clog << "############### test::DistributedMatchesSerial [" << typeid(*this).name() << "] ########" << endl;
+		clog << "HMT::Nodes objs created..." << endl;
+	}
+	virtual ~DistributedMatchesSerial() = default;
+
+	virtual void test(void) override
+	{
+		clog << std::boolalpha;
+		HMT::ConvergencePolicy l2, budget;
+		l2.norm = HMT::Norm::L2;
+		l2.checkEvery = 4;
+		budget.maxItterations = 50;
+		for (const HMT::ConvergencePolicy& policy : {HMT::ConvergencePolicy(), l2, budget}) {
+			HMT::Nodes<T> serial = this->_serial;
+			serial.setConvergencePolicy(policy);
+			const auto serialStart = std::chrono::high_resolution_clock::now();
+			serial.calculate(this->_epsilon);
+			const std::chrono::duration<double, std::milli> serialTime =
+				std::chrono::high_resolution_clock::now() - serialStart;
+			clog << (policy.norm == HMT::Norm::L2 ? "l2, checked every 4" :
+					policy.maxItterations > 0 ? "linf, 50 sweep budget" : "linf") << endl
+				 << "  serial: " << serial.getItterCount() << " itterations, "
+				 << std::setprecision(1) << serialTime.count() << std::setprecision(4) << " ms" << endl;
+			for (const unsigned int processCnt : this->_processCnts) {
+				HMT::Nodes<T> distributed = this->_serial;
+				distributed.setConvergencePolicy(policy);
+				distributed.setSolverMode(HMT::SolverMode::Distributed);
+				distributed.setProcessCount(processCnt);
+				const auto start = std::chrono::high_resolution_clock::now();
+				distributed.calculate(this->_epsilon);
+				const std::chrono::duration<double, std::milli> taken = std::chrono::high_resolution_clock::now() - start;
+				prec_t deviation = 0;
+				for (uint64_t i = 0; i < this->_nodeY; ++i)
+					for (uint64_t j = 0; j < this->_nodeX; ++j)
+						deviation = std::max<prec_t>(deviation,
+							std::fabs(distributed.getTemp(j, i) - serial.getTemp(j, i)));
+				clog << "  " << distributed.getProcessCount() << " processes: " << distributed.getItterCount()
+					 << " itterations (same: " << (distributed.getItterCount() == serial.getItterCount())
+					 << ", converged: " << distributed.hasConverged() << "), max deviation " << std::scientific
+					 << deviation << std::fixed << ", " << std::setprecision(1) << taken.count()
+					 << std::setprecision(4) << " ms" << endl;
+			}
+		}
+		clog << "################################################################################" << endl
+			 << endl;
+	}
+
+private:
+	HMT::Nodes<T> _serial;
+	prec_t _epsilon;
+	uint64_t _nodeX, _nodeY;
+	std::vector<unsigned int> _processCnts;
+};
+
+template<typename T>
+class GridMemoryPlacement: public IUnitTest
+{
+public:
+	GridMemoryPlacement(uint64_t nodeX, uint64_t nodeY,
+			T tempNorth, T tempEast, T tempSouth, T tempWest,
+			uint64_t sweeps, unsigned int threadCnt,
+			const std::vector<std::pair<std::pair<uint64_t, uint64_t>, T>>& tempHeatSrc): _nodeX(nodeX), _nodeY(nodeY),
+				_tempNorth(tempNorth), _tempEast(tempEast), _tempSouth(tempSouth), _tempWest(tempWest),
+				_sweeps(sweeps), _threadCnt(threadCnt), _tempHeatSrc(tempHeatSrc)
+	{
+		clog << "############### test::GridMemoryPlacement [" << typeid(*this).name() << "] ########" << endl;
+	}
+	virtual ~GridMemoryPlacement() = default;
+
+	virtual void test(void) override
+	{
+		clog << std::boolalpha;
+		const HMT::GridMemoryPolicy original = HMT::GridMemory::getPolicy();
+		HMT::GridMemory::setPolicy(HMT::GridMemoryPolicy());
+		HMT::Nodes<T> serial = this->plate(1);
+		serial.calculate(0);
+		clog << "serial, 4 KB pages: " << serial.getItterCount() << " sweeps" << endl;
+		for (const HMT::HugePages hugePages : {HMT::HugePages::Off, HMT::HugePages::Transparent, HMT::HugePages::Explicit}) {
+			HMT::GridMemoryPolicy policy;
+			policy.hugePages = hugePages;
+			policy.firstTouch = true;
+			policy.pinWorkers = true;
+			HMT::GridMemory::setPolicy(policy);
+			const HMT::GridMemoryStats before = HMT::GridMemory::getStats();
+			HMT::Nodes<T> threaded = this->plate(this->_threadCnt);
+			const auto start = std::chrono::high_resolution_clock::now();
+			threaded.calculate(0);
+			const std::chrono::duration<double, std::milli> taken = std::chrono::high_resolution_clock::now() - start;
+			const HMT::GridMemoryStats after = HMT::GridMemory::getStats();
+			bool isSame = threaded.getItterCount() == serial.getItterCount();
+			for (uint64_t i = 0; i < this->_nodeY && isSame; ++i)
+				for (uint64_t j = 0; j < this->_nodeX && isSame; ++j)
+					isSame = threaded.getTemp(j, i) == serial.getTemp(j, i);
+			clog << (hugePages == HMT::HugePages::Off ? "4 KB pages" :
+					hugePages == HMT::HugePages::Transparent ? "transparent" : "explicit")
+				 << ", first touch x" << this->_threadCnt << ": bitwise same: " << isSame
+				 << ", mapped " << ((after.mappedBytes - before.mappedBytes) >> 20) << " MB"
+				 << " (transparent " << ((after.transparentBytes - before.transparentBytes) >> 20)
+				 << ", explicit " << ((after.explicitBytes - before.explicitBytes) >> 20)
+				 << ", fallbacks " << after.fallbacks - before.fallbacks << ")"
+				 << ", placed " << ((after.placedBytes - before.placedBytes) >> 20) << " MB"
+				 << ", resident huge " << (HMT::GridMemory::residentHugeBytes() >> 20) << " MB, "
+				 << std::setprecision(1) << taken.count() << std::setprecision(4) << " ms" << endl;
+		}
+		// blocks mapped under one policy are freed after it changed
+		HMT::GridMemory::setPolicy(original);
+		clog << "################################################################################" << endl
+			 << endl;
+	}
+
+protected:
+	HMT::Nodes<T> plate(const unsigned int threadCnt) const
+	{
+		HMT::Nodes<T> nodes(this->_nodeX, this->_nodeY);
+		nodes.setWallTemp(this->_tempNorth, this->_tempEast, this->_tempSouth, this->_tempWest);
+		for (const auto& i : this->_tempHeatSrc)
+			nodes.setHeatSource(i.first.first, i.first.second, i.second);
+		nodes.canUseThreads(threadCnt > 1);
+		nodes.setThreadCount(threadCnt);
+		HMT::ConvergencePolicy budget;
+		budget.maxItterations = this->_sweeps;
+		nodes.setConvergencePolicy(budget);
+		return nodes;
+	}
+
+private:
+	uint64_t _nodeX, _nodeY;
+	T _tempNorth, _tempEast, _tempSouth, _tempWest;
+	uint64_t _sweeps;
+	unsigned int _threadCnt;
+	std::vector<std::pair<std::pair<uint64_t, uint64_t>, T>> _tempHeatSrc;
+};
+
+template<typename T>
+class AsyncSolveControl: public IUnitTest
+{
+public:
+	AsyncSolveControl(uint64_t nodeX, uint64_t nodeY,
+			T tempNorth, T tempEast, T tempSouth, T tempWest,
+			T epsilon, std::chrono::milliseconds deadline,
+			const std::vector<std::pair<std::pair<uint64_t, uint64_t>, T>>& tempHeatSrc): _epsilon(epsilon),
+				_nodeX(nodeX), _nodeY(nodeY), _deadline(deadline)
+	{
+		this->_nodes = HMT::Nodes<T>(nodeX, nodeY);
+		this->_nodes.setWallTemp(tempNorth, tempEast, tempSouth, tempWest);
+		for (const auto& i : tempHeatSrc) {
+			this->_nodes.setHeatSource(i.first.first, i.first.second, i.second);
+		}
+		clog << "############### test::AsyncSolveControl [" << typeid(*this).name() << "] ########" << endl;
+		clog << "HMT::Nodes objs created..." << endl;
+	}
+	virtual ~AsyncSolveControl() = default;
+
+	virtual void test(void) override
+	{
+		typedef HMT::SolveControl::clock clock;
+		clog << std::boolalpha;
+		HMT::AsyncSolver<T> solver(2);
+
+		// undisturbed, it is the blocking solve on another thread
+		HMT::Nodes<T> blocking = this->_nodes;
+		blocking.calculate(this->_epsilon);
+		const HMT::SolveHandle<T> plain = solver.submit(this->_nodes, this->_epsilon);
+		const HMT::Nodes<T>& solved = plain.get();
+		clog << "plain: " << statusName(plain.getProgress().status) << " after " << solved.getItterCount()
+			 << " itterations, bitwise same as blocking: " << this->isSame(solved, blocking) << endl;
+
+		// a traced, checkpointing, threaded plate solved here and then submitted twice:
+		// the copies get pools of their own and leave the ring and checkpoint to the plate
+		const std::string checkpointPath = "./bin/test.async.checkpoint";
+		HMT::Nodes<T> traced = this->_nodes;
+		const std::shared_ptr<HMT::Telemetry> plateTelemetry = std::make_shared<HMT::Telemetry>(64);
+		const std::shared_ptr<HMT::Telemetry> ownTelemetry = std::make_shared<HMT::Telemetry>(64);
+		plateTelemetry->setCounting(true);
+		ownTelemetry->setCounting(true);
+		traced.setTelemetry(plateTelemetry);
+		traced.setCheckpointing(checkpointPath, 10);
+		traced.canUseThreads(true);
+		traced.setThreadCount(3);
+		traced.calculate(this->_epsilon);
+		// back to a cold interior, pool kept; solved once more untraced here as the reference
+		const std::vector<T> cold(this->_nodeX * this->_nodeY, static_cast<T>(0));
+		traced.setInitialGuess(cold.data());
+		HMT::Nodes<T> reference = traced;
+		reference.setTelemetry(nullptr);
+		reference.setCheckpointing(std::string(), 0);
+		reference.calculate(this->_epsilon);
+		std::remove(checkpointPath.c_str());
+		const uint64_t plateSweeps = plateTelemetry->getSweepCount();
+		const HMT::SolveHandle<T> once = solver.submit(traced, this->_epsilon);
+		const HMT::SolveHandle<T> twice = solver.submit(traced, this->_epsilon, clock::time_point::max(), ownTelemetry);
+		const HMT::Nodes<T>& onceSolved = once.get();
+		const HMT::Nodes<T>& twiceSolved = twice.get();
+		struct stat info;
+		clog << "one traced plate submitted twice, both bitwise same as solving it here: "
+			 << (this->isSame(onceSolved, reference) && this->isSame(twiceSolved, reference)) << endl
+			 << "  sweeps traced on the plate / the second submission: " << plateTelemetry->getSweepCount() - plateSweeps
+			 << " / " << ownTelemetry->getSweepCount() << " of " << twiceSolved.getItterCount()
+			 << ", a copy left on the plate's telemetry: " << (onceSolved.getTelemetry() != nullptr || twiceSolved.getTelemetry() != ownTelemetry)
+			 << ", checkpoint rewritten: " << (::stat(checkpointPath.c_str(), &info) == 0) << endl;
+
+		// cancelled once it is under way, epsilon 0 never converges on its own
+		const HMT::SolveHandle<T> running = solver.submit(this->_nodes, 0);
+		while (running.getProgress().itterCnt < 100)
+			std::this_thread::yield();
+		running.cancel();
+		const HMT::Nodes<T>& cancelled = running.get();
+		clog << "cancelled while running: " << statusName(running.getProgress().status) << " after "
+			 << cancelled.getItterCount() << " itterations, converged: " << cancelled.hasConverged()
+			 << ", centre " << cancelled.getTemp(this->_nodeX / 2, this->_nodeY / 2) << endl;
+
+		// both workers busy, so the third one is still queued when it is cancelled
+		const HMT::SolveHandle<T> first = solver.submit(this->_nodes, 0), second = solver.submit(this->_nodes, 0);
+		const HMT::SolveHandle<T> queued = solver.submit(this->_nodes, 0);
+		const bool wasQueued = queued.getProgress().status == HMT::SolveStatus::Queued;
+		queued.cancel();
+		first.cancel();
+		second.cancel();
+		const HMT::Nodes<T>& unstarted = queued.get();
+		clog << "cancelled while queued (" << wasQueued << "): " << statusName(queued.getProgress().status)
+			 << " after " << unstarted.getItterCount() << " itterations, converged: " << unstarted.hasConverged()
+			 << ", centre " << unstarted.getTemp(this->_nodeX / 2, this->_nodeY / 2) << endl;
+
+		// every mode, run into a deadline
+		const std::vector<std::pair<const char*, HMT::SolverMode>> modes = {
+			{"jacobi", HMT::SolverMode::Jacobi}, {"sor", HMT::SolverMode::RedBlackSOR},
+			{"multigrid", HMT::SolverMode::Multigrid}, {"cg", HMT::SolverMode::ConjugateGradient},
+			{"tiled", HMT::SolverMode::TiledJacobi}, {"mixed", HMT::SolverMode::MixedPrecision},
+			{"distributed", HMT::SolverMode::Distributed}, {"adi", HMT::SolverMode::ADI}};
+		for (const auto& mode : modes) {
+			for (const unsigned int threadCnt : {1u, 3u}) {
+				HMT::Nodes<T> nodes = this->_nodes;
+				nodes.setSolverMode(mode.second);
+				nodes.canUseThreads(threadCnt > 1);
+				nodes.setThreadCount(threadCnt);
+				nodes.setProcessCount(threadCnt);
+				const clock::time_point start = clock::now();
+				const HMT::SolveHandle<T> handle = solver.submit(nodes, 0, start + this->_deadline);
+				handle.wait();
+				const std::chrono::duration<double, std::milli> taken = clock::now() - start;
+				clog << "  " << mode.first << " x" << threadCnt << ": " << statusName(handle.getProgress().status)
+					 << " after " << handle.get().getItterCount() << " itterations, " << std::setprecision(1)
+					 << taken.count() << std::setprecision(4) << " ms, converged: " << handle.get().hasConverged() << endl;
+			}
+		}
+		clog << "################################################################################" << endl
+			 << endl;
+	}
+
+protected:
+	static const char* statusName(const HMT::SolveStatus status)
+	{
+		switch (status) {
+			case HMT::SolveStatus::Queued: return "queued";
+			case HMT::SolveStatus::Running: return "running";
+			case HMT::SolveStatus::Converged: return "converged";
+			case HMT::SolveStatus::Unconverged: return "unconverged";
+			case HMT::SolveStatus::Cancelled: return "cancelled";
+			case HMT::SolveStatus::DeadlineExceeded: return "deadline exceeded";
+		}
+		return "";
+	}
+
+	bool isSame(const HMT::Nodes<T>& a, const HMT::Nodes<T>& b) const
+	{
+		if (a.getItterCount() != b.getItterCount())
+			return false;
+		for (uint64_t i = 0; i < this->_nodeY; ++i)
+			for (uint64_t j = 0; j < this->_nodeX; ++j)
+				if (a.getTemp(j, i) != b.getTemp(j, i))
+					return false;
+		return true;
+	}
+
+private:
+	HMT::Nodes<T> _nodes;
+	prec_t _epsilon;
+	uint64_t _nodeX, _nodeY;
+	std::chrono::milliseconds _deadline;
+};
+
+template<typename T>
+class RefinedNodesAccuracy: public IUnitTest
+{
+public:
+	RefinedNodesAccuracy(uint64_t nodeX, uint64_t nodeY,
+			T tempNorth, T tempEast, T tempSouth, T tempWest,
+			T epsilon, uint64_t radius, unsigned int ratio,
+			const std::vector<std::pair<std::pair<uint64_t, uint64_t>, T>>& tempHeatSrc): _epsilon(epsilon),
+				_nodeX(nodeX), _nodeY(nodeY), _radius(radius), _ratio(ratio),
+				_coarse(nodeX, nodeY), _refined(nodeX, nodeY), _gradient(nodeX, nodeY)
+	{
+		this->_fine = HMT::Nodes<T>((nodeX - 1) * ratio + 1, (nodeY - 1) * ratio + 1);
+		this->_fine.setWallTemp(tempNorth, tempEast, tempSouth, tempWest);
+		this->_fine.setSolverMode(HMT::SolverMode::Multigrid);
+		for (HMT::RefinedNodes<T>* nodes : {&this->_coarse, &this->_refined, &this->_gradient}) {
+			nodes->setWallTemp(tempNorth, tempEast, tempSouth, tempWest);
+			nodes->setSolverMode(HMT::SolverMode::Multigrid);
+		}
+		for (const auto& i : tempHeatSrc) {
+			this->_fine.setHeatSource(i.first.first * ratio, i.first.second * ratio, i.second);
+			for (HMT::RefinedNodes<T>* nodes : {&this->_coarse, &this->_refined, &this->_gradient})
+				nodes->setHeatSource(i.first.first, i.first.second, i.second);
+		}
+		clog << "############### test::RefinedNodesAccuracy [" << typeid(*this).name() << "] ########" << endl;
+		clog << "HMT::Nodes objs created..." << endl;
+	}
+	virtual ~RefinedNodesAccuracy() = default;
+
+	virtual void test(void) override
+	{
+		clog << std::boolalpha;
+		const uint64_t patchCnt = this->_refined.refineAroundHeatSources(this->_radius, this->_ratio);
+		const uint64_t gradientCnt = this->_gradient.refineGradient(50, 2, this->_ratio, this->_epsilon);
+		this->_fine.calculate(this->_epsilon);
+		for (HMT::RefinedNodes<T>* nodes : {&this->_coarse, &this->_refined, &this->_gradient})
+			nodes->calculate(this->_epsilon);
+
+		// against the uniform fine plate, over the fine nodes of the first patch
+		const HMT::PatchBox& box = this->_refined.getPatch(0).getBox();
+		prec_t coarseErr = 0, refinedErr = 0, gradientErr = 0;
+		for (uint64_t i = box.y0 * this->_ratio; i <= box.y1 * this->_ratio; ++i) {
+			for (uint64_t j = box.x0 * this->_ratio; j <= box.x1 * this->_ratio; ++j) {
+				const prec_t x = static_cast<prec_t>(j) / this->_ratio, y = static_cast<prec_t>(i) / this->_ratio;
+				const prec_t exact = this->_fine.getTemp(j, i);
+				coarseErr = std::max<prec_t>(coarseErr, std::fabs(this->_coarse.getTemp(x, y) - exact));
+				refinedErr = std::max<prec_t>(refinedErr, std::fabs(this->_refined.getTemp(x, y) - exact));
+				gradientErr = std::max<prec_t>(gradientErr, std::fabs(this->_gradient.getTemp(x, y) - exact));
+			}
+		}
+
+		clog << "cells (coarse / refined / gradient / uniform fine): " << this->_coarse.getCellCount() << " / "
+			 << this->_refined.getCellCount() << " / " << this->_gradient.getCellCount() << " / "
+			 << (this->_nodeX - 1) * this->_ratio + 1 << "x" << (this->_nodeY - 1) * this->_ratio + 1 << endl
+			 << "patches (heat sources / gradient): " << patchCnt << " / " << gradientCnt << endl
+			 << "coupling iterations: " << this->_refined.getCouplingCount()
+			 << " (converged: " << this->_refined.hasConverged() << ")" << endl
+			 << "max error near the source (coarse / refined / gradient): " << std::scientific
+			 << coarseErr << " / " << refinedErr << " / " << gradientErr << std::fixed << endl
+			 << "refined beats coarse: " << (refinedErr < coarseErr) << endl
+			 << "################################################################################" << endl
+			 << endl;
+	}
+
+private:
+	prec_t _epsilon;
+	uint64_t _nodeX, _nodeY, _radius;
+	unsigned int _ratio;
+	HMT::RefinedNodes<T> _coarse, _refined, _gradient;
+	HMT::Nodes<T> _fine;
+};
+
+template<typename T>
+class NodesTelemetry: public IUnitTest
+{
+public:
+	NodesTelemetry(uint64_t nodeX, uint64_t nodeY,
+			T tempNorth, T tempEast, T tempSouth, T tempWest,
+			T epsilon, unsigned int threadCnt, uint64_t ringCapacity,
+			const std::vector<std::pair<std::pair<uint64_t, uint64_t>, T>>& tempHeatSrc): _epsilon(epsilon),
+				_nodeX(nodeX), _nodeY(nodeY), _ringCapacity(ringCapacity)
+	{
+		this->_plain = HMT::Nodes<T>(nodeX, nodeY);
+		this->_plain.setWallTemp(tempNorth, tempEast, tempSouth, tempWest);
+		for (const auto& i : tempHeatSrc) {
+			this->_plain.setHeatSource(i.first.first, i.first.second, i.second);
+		}
+		this->_plain.canUseThreads(true);
+		this->_plain.setThreadCount(threadCnt);
+		clog << "############### test::NodesTelemetry [" << typeid(*this).name() << "] ########" << endl;
+		clog << "HMT::Nodes objs created..." << endl;
+	}
+	virtual ~NodesTelemetry() = default;
+
+	virtual void test(void) override
+	{
+		clog << std::boolalpha;
+		for (const HMT::SolverMode mode : {HMT::SolverMode::Jacobi, HMT::SolverMode::RedBlackSOR}) {
+			HMT::Nodes<T> plain = this->_plain, traced = this->_plain;
+			plain.setSolverMode(mode);
+			traced.setSolverMode(mode);
+			std::shared_ptr<HMT::Telemetry> telemetry = std::make_shared<HMT::Telemetry>(this->_ringCapacity);
+			telemetry->setCounting(true);
+			uint64_t observed = 0;
+			HMT::SweepRecord last;
+			// worst busiest-worker over average-worker ratio of any sweep
+			double imbalance = 1;
+			telemetry->setObserver([&] (const HMT::SweepRecord& record) -> void {
+				++observed;
+				last = record;
+				std::chrono::nanoseconds busiest(0), total(0);
+				for (unsigned int i = 0; i < record.threadCnt; ++i) {
+					busiest = std::max(busiest, record.threadTimes[i]);
+					total += record.threadTimes[i];
+				}
+				if (total.count() > 0)
+					imbalance = std::max(imbalance, static_cast<double>(busiest.count()) * record.threadCnt / total.count());
+			});
+			traced.setTelemetry(telemetry);
+
+			// drain the ring from another thread while the solve runs
+			std::atomic<bool> isDone(false);
+			uint64_t popped = 0;
+			bool isOrdered = true;
+			std::thread reader([&] () -> void {
+				HMT::SweepRecord record;
+				uint64_t previous = 0;
+				while (true) {
+					const bool wasDone = isDone.load();
+					while (telemetry->pop(record)) {
+						isOrdered = isOrdered && record.itterCnt > previous;
+						previous = record.itterCnt;
+						++popped;
+					}
+					if (wasDone)
+						break;
+					std::this_thread::yield();
+				}
+			});
+			plain.calculate(this->_epsilon);
+			traced.calculate(this->_epsilon);
+			isDone.store(true);
+			reader.join();
+
+			bool identical = plain.getItterCount() == traced.getItterCount();
+			for (uint64_t i = 0; identical && i < this->_nodeY; ++i)
+				for (uint64_t j = 0; j < this->_nodeX; ++j)
+					identical = identical && plain.getTemp(j, i) == traced.getTemp(j, i);
+			const uint64_t cells = (this->_nodeX - 2) * (this->_nodeY - 2);
+
+			clog << (mode == HMT::SolverMode::Jacobi ? "jacobi" : "sor") << " (" << last.threadCnt << " threads)" << endl
+				 << "  bitwise identical to an untraced solve: " << identical << endl
+				 << "  observed every sweep: " << (observed == traced.getItterCount()) << endl
+				 << "  ring popped + dropped: " << popped << " + " << telemetry->dropCount()
+				 << " (in order: " << isOrdered << ")" << endl
+				 << "  last residual matches history: "
+				 << (last.residual == traced.getResidualHistory().back()) << endl
+				 << "  cells counted: " << (telemetry->getCellsUpdated() == cells * traced.getItterCount()) << ", "
+				 << telemetry->getBytesMoved() << " bytes" << endl
+				 << "  worst load imbalance: " << std::setprecision(2) << imbalance << std::setprecision(4) << endl;
+		}
+		clog << "################################################################################" << endl
+			 << endl;
+	}
+
+private:
+	HMT::Nodes<T> _plain;
+	prec_t _epsilon;
+	uint64_t _nodeX, _nodeY, _ringCapacity;
+};
+
 }
\ No newline at end of file